@@ -0,0 +1,87 @@
+/**
+ * Opening Book Compiler for the 3700.network Project - Client Word Solver
+ *
+ * This program records the decisions a strategy makes for the first guesses
+ * of every possible game and writes them to the opening book file the client
+ * maps at startup (see solver_book.c for the format). The decisions are made
+ * with the answer prior of the history file when there is one (by default the
+ * snapshot the client builds its prior from), as the client makes them, and
+ * the book only applies while the client has the same prior.
+ *
+ * Usage: ./bookc <-g strategy> <-d depth> <-t threads> <-h history-file> <-o output-file>
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+int main(int argc, char *argv[])
+{
+    Strategy strategy = STRATEGY_ENTROPY;
+    int depth = BOOK_DEFAULT_DEPTH;
+    int num_threads = 0;
+    const char *output_path = BOOK_FILE;
+    const char *history_path = PRIOR_FILE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:d:t:h:o:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'g':
+            if (strategy_from_name(optarg, &strategy) == -1)
+            {
+                fprintf(stderr, "Unknown strategy: %s\n", optarg);
+                exit(1);
+            }
+            break;
+        case 'd':
+            depth = atoi(optarg);
+            break;
+        case 't':
+            num_threads = atoi(optarg);
+            break;
+        case 'h':
+            history_path = optarg;
+            break;
+        case 'o':
+            output_path = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: ./bookc <-g strategy> <-d depth> <-t threads> <-h history-file> <-o output-file>\n");
+            exit(1);
+        }
+    }
+    if (depth < 1)
+    {
+        depth = 1;
+    }
+
+    // Use the pattern matrix if it was generated, but never an older book
+    Solver solver;
+    if (solver_open(&solver, WORD_LIST_FILE, DICT_FILE, PATTERN_FILE, NULL) == -1)
+    {
+        perror(WORD_LIST_FILE);
+        exit(1);
+    }
+    if (dict_check(&solver.dict, WORD_LIST_FILE) == -1)
+    {
+        exit(1);
+    }
+    solver_set_threads(&solver, num_threads);
+    solver_set_prior(&solver, history_path);
+    solver.endgame_budget_ms = 0; // The book must not depend on how busy the machine was
+
+    int num_nodes = book_write(&solver, strategy, depth, output_path);
+    if (num_nodes == -1)
+    {
+        perror(output_path);
+        exit(1);
+    }
+    printf("%s: %s, %d guesses, %d nodes, prior of %d games\n", output_path, strategy_name(strategy), depth, num_nodes,
+           solver.prior.num_games);
+
+    solver_close(&solver);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * Decision Cache Compactor for the 3700.network Project - Client Word Solver
+ *
+ * The decision cache file only grows: every process appends the decisions it
+ * computed, including ones another process already recorded. This program
+ * rewrites it with one entry per game state (see solver_cache.c). It refuses
+ * to run while a client has the file open, since the client's appends would
+ * go to the replaced file.
+ *
+ * Usage: ./cachec <-i cache-file>
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+
+int main(int argc, char *argv[])
+{
+    const char *cache_path = CACHE_FILE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "i:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'i':
+            cache_path = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: ./cachec <-i cache-file>\n");
+            exit(1);
+        }
+    }
+
+    Dictionary dict;
+    if (dict_load(&dict, WORD_LIST_FILE) == -1)
+    {
+        perror(WORD_LIST_FILE);
+        exit(1);
+    }
+
+    int num_entries = 0;
+    int kept = cache_compact(&dict, cache_path, &num_entries);
+    if (kept == -1 && errno == EWOULDBLOCK)
+    {
+        fprintf(stderr, "%s is in use by a running client, compact it once the clients have exited\n", cache_path);
+        exit(1);
+    }
+    if (kept == -1)
+    {
+        perror(cache_path);
+        exit(1);
+    }
+    printf("%s: %d entries, %d after compaction\n", cache_path, num_entries, kept);
+
+    dict_free(&dict);
+    return 0;
+}
@@ -37,18 +37,24 @@ int main(int argc, char *argv[])
     SSL *ssl = NULL;
     int use_tls = 0;
 
+    // How the game is played
+    GameOptions options;
+
     // Buffer to store message from server, in order to get game_id
     char *buffer;
     buffer = (char *)malloc(1024); // Allocate memory for the buffer
 
+    // Hand over to the build for the word list's word length if this is not it
+    select_word_len(argv);
+
     // First, check user's command line input
-    check_input(argc, argv, &port_number, &name_of_server, &user, &use_tls);
+    check_input(argc, argv, &port_number, &name_of_server, &user, &use_tls, &options);
 
     // Get address information of server and get the socket file descriptor
     setup_connection(name_of_server, port_number, &sockfd);
 
-    // Check if port number is 27994 -> TSL handshake
-    if (strcmp(port_number, "27994") == 0)
+    // Check if TLS was requested (-s or port 27994) -> TSL handshake
+    if (use_tls)
     {
         init_ssl();
         // Create and configure SSL context
@@ -67,7 +73,7 @@ int main(int argc, char *argv[])
     get_message_from_json(game_id, buffer, "id");
 
     // Play game
-    play_game(sockfd, game_id, ssl, use_tls);
+    play_game(sockfd, game_id, ssl, use_tls, &options);
 
     // Cleanup OpenSSL
     if (use_tls)
@@ -20,19 +20,73 @@
 #include <netdb.h>       // For struct addrinfo
 #include <openssl/ssl.h> // For SSL connection
 #include <openssl/err.h>
+#include "solver.h"      // For Strategy
 
 // Constant definitions
 #define SERVER_HOSTNAME "proj1.3700.network"
 #define NON_TLS_PORT "27993"
 #define TLS_PORT "27994"
+#define RESPONSE_BUFFER_SIZE 262144 // Largest server response to a guess
+
+#define USAGE "Usage: ./client <-p port> <-s> <-g first|entropy|timed|frequency|plugin.so> <-t threads> <-b budget-ms> <hostname> <Northeastern-username>\n"
+
+/**
+ * Options that control how the game is played.
+ */
+typedef struct
+{
+    Strategy strategy; // How the next guess is picked
+    int num_threads;   // Threads scoring guesses (1 = no worker pool, 0 = one per online core)
+    int budget_us;     // Time allowed per decision in microseconds (0 = no limit)
+    int speculate;     // 1 to decide ahead for the likely responses while waiting for the server
+} GameOptions;
+
+#define GAME_MAX_DECISIONS 64 // Decision latencies recorded per game
+#define GAME_MAX_HISTORY 64   // Guesses read from the server's record of a game
+
+/**
+ * Sends one guess and reports the server's verdict.
+ * @param context The transport (a server connection, or the simulator's local oracle).
+ * @param guess Dictionary index of the guess.
+ * @param word The guessed word.
+ * @param marks Receives the marks for each position when the guess was wrong.
+ * @param history Receives every guess of the game so far, this one included, when
+ *                the transport keeps a record of the game (GAME_MAX_HISTORY entries).
+ * @param num_history Receives the number of guesses in history, 0 if the transport keeps no record.
+ * @return 1 if the guess was the secret, 0 if marks were received, -1 if the game cannot continue.
+ */
+typedef int (*GuessExchange)(void *context, int guess, const char *word, int *marks, GuessRecord *history, int *num_history);
+
+/**
+ * What happened during one game.
+ */
+typedef struct
+{
+    int num_guesses;
+    int solved;
+    int num_decisions;                         // Decisions timed (at most GAME_MAX_DECISIONS)
+    uint64_t decision_ns[GAME_MAX_DECISIONS]; // Time to pick each guess
+    int survivors[GAME_MAX_DECISIONS];         // Candidates left when each guess was picked
+    uint8_t computed[GAME_MAX_DECISIONS];      // 1 if the strategy computed the guess (not the book or table)
+    int budget_hits;                           // Decisions cut short by the time budget
+    int speculated;                            // Decisions made ahead while waiting for the response
+    int cheap_picks;                           // Decisions the timed strategy left to first-fit
+    int resyncs;                               // Times the game was rebuilt from the transport's record
+    uint64_t game_ns;                          // Wall time of the whole game
+    uint64_t exchange_ns;                      // Time spent waiting for the server
+} GameStats;
 
 void error(const char *message);
-void check_input(int argc, char *argv[], char **port_number, char **name_of_server, char **user, int *use_tls);
+void select_word_len(char *argv[]);
+void check_input(int argc, char *argv[], char **port_number, char **name_of_server, char **user, int *use_tls, GameOptions *options);
 void print_addrinfo(struct addrinfo *address_info);
 void get_message_from_json(char *message, char *message_json, char *key);
 void setup_connection(const char *hostname, const char *port, int *sockfd);
 void send_hello_message(int sockfd, const char *user, char *buffer, SSL *ssl, int use_tls);
-void play_game(int sockfd, const char *game_id, SSL *ssl, int use_tls);
+void play_game(int sockfd, const char *game_id, SSL *ssl, int use_tls, const GameOptions *options);
+void play_rounds(const Solver *solver, const GameOptions *options, GuessExchange exchange, void *context, GameStats *stats);
+int retreive_hints(const char *guesses_from_server, GuessRecord *history, int max);
+int exchange_guess(int sockfd, SSL *ssl, int use_tls, const char *game_id, const char *word, char *buffer, int buffer_size);
 
 // TSL handshake
 void init_ssl();
@@ -3,7 +3,8 @@
  *
  * This source file implements the core functionalities of the client application,
  * including game logic for guessing, and management of game resources.
- * It utilizes cJSON for JSON parsing and a set data structure for maintaining game state.
+ * It utilizes cJSON for JSON parsing and the game state from solver.h (constraint state,
+ * surviving candidates and opening book position) for maintaining game state.
  */
 
 #include "client.h"
@@ -14,15 +15,22 @@
 #include <string.h>
 #include <unistd.h>
 #include "cJSON.h"
-#include "set.h" // using set data structure
+#include "solver.h" // encoded dictionary and game state
 
 /**
- * Parses the last guess and its hints from the server response.
+ * Parses every guess and its hints from a server response, in the order they were made.
  * @param guesses_from_server The JSON string containing guesses from the server.
- * @param hint The array to store the hint (correctly guessed characters).
- * @param garbage_alphabets Set of alphabets that are not in the word.
+ * @param history Receives the guesses.
+ * @param max The number of guesses history can hold.
+ * @return The number of guesses parsed, or -1 if the response holds no guesses
+ *         array, a guess is malformed, a mark is not 0, 1 or 2 or there are
+ *         more than max guesses.
+ *
+ * Note: With game_rebuild(), the last response is all it takes to take a game
+ * over mid-flight, in any thread or process. play_rounds() does so whenever the
+ * server's record is not the game it played (game_resync()).
  */
-void retreive_last_hint(const char *guesses_from_server, char *hint, SimpleSet garbage_alphabets)
+int retreive_hints(const char *guesses_from_server, GuessRecord *history, int max)
 {
     cJSON *json = cJSON_Parse(guesses_from_server);
     if (json == NULL)
@@ -33,7 +41,7 @@ void retreive_last_hint(const char *guesses_from_server, char *hint, SimpleSet g
             printf("Error: %s\n", error_ptr);
         }
         cJSON_Delete(json);
-        return;
+        return -1;
     }
 
     // Access guesses in json object
@@ -42,101 +50,199 @@ void retreive_last_hint(const char *guesses_from_server, char *hint, SimpleSet g
     {
         fprintf(stderr, "Error: guesses is not an array\n");
         cJSON_Delete(json);
-        return;
-    }
-
-    // Traverse the array from the end
-    cJSON *last_guess = NULL;
-    if (cJSON_GetArraySize(guesses) > 0)
-    {
-        last_guess = cJSON_GetArrayItem(guesses, cJSON_GetArraySize(guesses) - 1);
+        return -1;
     }
 
-    // Retreive the latest guess and hint for future guess
-    if (last_guess != NULL)
+    int count = 0;
+    cJSON *guess;
+    cJSON_ArrayForEach(guess, guesses)
     {
-        cJSON *word = cJSON_GetObjectItemCaseSensitive(last_guess, "word");
-        cJSON *marks = cJSON_GetObjectItemCaseSensitive(last_guess, "marks");
-
-        // Get the latest guess
-        if (word->valuestring == NULL)
+        if (count == max)
         {
-            error("Guess word: ");
+            count = -1;
+            break;
+        }
+        cJSON *guess_word = cJSON_GetObjectItemCaseSensitive(guess, "word");
+        cJSON *guess_marks = cJSON_GetObjectItemCaseSensitive(guess, "marks");
+        if (!cJSON_IsString(guess_word) || guess_word->valuestring == NULL || strlen(guess_word->valuestring) != WORD_LEN ||
+            !cJSON_IsArray(guess_marks) || cJSON_GetArraySize(guess_marks) != WORD_LEN)
+        {
+            count = -1;
+            break;
         }
-        // Get the latest hint
-        if (cJSON_IsArray(marks))
+        GuessRecord *record = &history[count++];
+        memcpy(record->word, guess_word->valuestring, WORD_LEN + 1);
+        for (int i = 0; i < WORD_LEN; i++)
         {
-            int num_marks = cJSON_GetArraySize(marks);
-            for (int i = 0; i < num_marks; i++)
+            cJSON *mark = cJSON_GetArrayItem(guess_marks, i);
+            record->marks[i] = cJSON_IsNumber(mark) && mark->valueint >= 0 && mark->valueint <= 2 ? mark->valueint : -1;
+            if (record->marks[i] == -1)
             {
-                cJSON *mark = cJSON_GetArrayItem(marks, i);
-
-                if (cJSON_IsNumber(mark) && mark->valueint == 2) // check if the hint is 2
-                {
-                    // hint structure will look like
-                    // index 0,  1,  2,  3,  4
-                    // value nul, a, e, nul, nul
-                    hint[i] = word->valuestring[i];
-                }
-                else if (cJSON_IsNumber(mark) && mark->valueint == 0) // check if the hint is 0
-                {
-                    // add the alphabet not in used to set data structure
-                    set_add(&garbage_alphabets, &(word->valuestring[i]));
-                }
+                count = -1;
             }
         }
+        if (count == -1)
+        {
+            fprintf(stderr, "Error: mark out of range\n");
+            break;
+        }
     }
     cJSON_Delete(json);
+    return count;
 }
 
 /**
- * Checks if the given word is a good guess based on the hint and garbage alphabets.
- * @param word The word to check.
- * @param hint Array of hints where correctly guessed characters are stored.
- * @param garbage_alphabets Set of alphabets not in the answer.
- * @return 1 if the word is a good guess, 0 otherwise.
+ * Plays rounds until the secret is found: picks a guess, hands it to the transport,
+ * and folds the marks it gets back into the game state.
+ * The transport is the server connection in play_game() and a local oracle in the simulator.
+ * With options->speculate, the next decision is made ahead in the background
+ * while the transport waits for the response (solver_speculate.c).
+ * @param solver The solver holding the dictionary, pattern matrix and opening book.
+ * @param options The game options, including the guess strategy.
+ * @param exchange Sends a guess and receives its marks.
+ * @param context The transport passed to exchange.
+ * @param stats Receives the number of guesses, the time spent on each decision and the wall time of the game.
  */
-int is_good_word_to_guess(const char *word, const char *hint, SimpleSet *garbage_alphabets)
+void play_rounds(const Solver *solver, const GameOptions *options, GuessExchange exchange, void *context, GameStats *stats)
 {
-    for (int i = 0; word[i] != '\0'; i++)
+    memset(stats, 0, sizeof(*stats));
+
+    // Everything the server told us so far, and the words still consistent with it
+    GameState game;
+    if (game_init(&game, solver) == -1)
     {
-        if (hint[i] != '\0' && word[i] != hint[i])
+        // Without memory for the survivors the game is reported as not solved
+        game_free(&game);
+        return;
+    }
+    game.budget_us = options->budget_us;
+    GuessRecord history[GAME_MAX_HISTORY]; // The transport's record of the game, when it keeps one
+    uint64_t game_start = timing_now_ns();
+
+    while (game.candidates.count > 0)
+    {
+        // Pick the next guess from the opening book or with the selected strategy
+        int survivors = game.candidates.count;
+        int num_computed = game.num_computed;
+        uint64_t start = timing_now_ns();
+        int guess = game_next_guess(&game, solver, options->strategy);
+        if (stats->num_decisions < GAME_MAX_DECISIONS)
         {
-            // Discard word that does not match tthe hint
-            return 0;
+            stats->decision_ns[stats->num_decisions] = timing_now_ns() - start;
+            stats->survivors[stats->num_decisions] = survivors;
+            stats->computed[stats->num_decisions] = game.num_computed != num_computed;
+            stats->num_decisions++;
         }
-        if (set_contains(garbage_alphabets, &word[i]) == SET_TRUE)
+
+        // While the guess is on its way, decide ahead for the likely responses
+        Speculation *spec = options->speculate ? speculation_start(solver, &game, options->strategy, guess) : NULL;
+
+        const DictWord *word = &solver->dict.words[guess];
+        int marks[WORD_LEN];
+        int num_history = 0;
+        stats->num_guesses++;
+        uint64_t sent = timing_now_ns();
+        int result = exchange(context, guess, word->text, marks, history, &num_history);
+        uint64_t round_trip = timing_now_ns() - sent;
+        stats->exchange_ns += round_trip;
+
+        // The speculation reads the game, so it must be over before the game changes
+        stats->speculated += speculation_finish(spec, result == 0 ? pattern_from_marks(marks) : -1);
+        timing_observe_rtt(&game, round_trip);
+        if (result == 1)
         {
-            // Found garbage alphabet, return 0
-            return 0;
+            stats->solved = 1;
+            break;
+        }
+        if (result == -1)
+        {
+            break;
         }
+
+        // Drop the words the hint rules out, or take the game over from the transport's record if it is not the game played here
+        if (num_history > 0 &&
+            (num_history != game.num_guesses + 1 || strncmp(history[num_history - 1].word, word->text, WORD_LEN) != 0))
+        {
+            if (game_resync(&game, solver, history, num_history) == -1)
+            {
+                break;
+            }
+            stats->resyncs++;
+        }
+        else if (game_observe(&game, solver, word->text, marks) == -1)
+        {
+            break;
+        }
+    }
+    stats->budget_hits = game.budget_hits;
+    stats->cheap_picks = game.cheap_picks;
+    stats->game_ns = timing_now_ns() - game_start;
+    game_free(&game);
+}
+
+/**
+ * A connection to the game server, used as the transport of play_rounds().
+ */
+typedef struct
+{
+    int sockfd;
+    SSL *ssl;
+    int use_tls;
+    const char *game_id;
+    char *buffer; // Message received
+} ServerExchange;
+
+/**
+ * Sends a guess to the server and parses its response.
+ * Prints the secret flag when the server says "bye".
+ */
+static int server_exchange(void *context, int guess, const char *word, int *marks, GuessRecord *history, int *num_history)
+{
+    ServerExchange *server = (ServerExchange *)context;
+    exchange_guess(server->sockfd, server->ssl, server->use_tls, server->game_id, word, server->buffer, RESPONSE_BUFFER_SIZE);
+
+    // If guess the correct answer
+    char correct_message[256] = "";
+    get_message_from_json(correct_message, server->buffer, "type");
+    if (strcmp(correct_message, "bye") == 0)
+    {
+        char ans[64];
+        get_message_from_json(ans, server->buffer, "flag");
+        printf("%s\n", ans);
+
+        // Remember the secret, so later games favor the words the server picks
+        history_record(HISTORY_FILE, word);
+        return 1;
     }
-    return 1;
+
+    // Get the hint by server: the marks of the last guess of its record of the game
+    *num_history = retreive_hints(server->buffer, history, GAME_MAX_HISTORY);
+    if (*num_history <= 0)
+    {
+        *num_history = 0;
+        return -1;
+    }
+    memcpy(marks, history[*num_history - 1].marks, sizeof(history[0].marks));
+    return 0;
 }
 
 /**
- * Cleans up game resources including allocated memory for buffer, hint, and garbage alphabets set.
+ * Cleans up game resources including the allocated buffer and the solver data.
  *
  * @param buffer A pointer to a dynamically allocated memory buffer, to be freed.
- * @param hint A pointer to a dynamically allocated hint array, to be freed.
- * @param garbage_alphabets A pointer to a SimpleSet struct, which holds the set of garbage alphabets.
+ * @param solver A pointer to the solver holding the dictionary and pattern matrix, to be released.
  *
  */
-void cleanup_game_resources(char **buffer, char **hint, SimpleSet *garbage_alphabets)
+void cleanup_game_resources(char **buffer, Solver *solver)
 {
     if (buffer != NULL && *buffer != NULL)
     {
         free(*buffer);
         *buffer = NULL;
     }
-    if (hint != NULL && *hint != NULL)
-    {
-        free(*hint);
-        *hint = NULL;
-    }
-    if (garbage_alphabets != NULL)
+    if (solver != NULL)
     {
-        set_destroy(garbage_alphabets);
+        solver_close(solver);
     }
 }
 
@@ -146,103 +252,30 @@ void cleanup_game_resources(char **buffer, char **hint, SimpleSet *garbage_alpha
  * @param ssl The SSL structure for TLS communication (can be NULL for non-TLS).
  * @param game_id The game ID for the current session.
  * @param use_tls A flag indicating whether to use TLS (1 for TLS, 0 for non-TLS).
+ * @param options The game options, including the guess strategy.
  */
-void play_game(int sockfd, const char *game_id, SSL *ssl, int use_tls)
+void play_game(int sockfd, const char *game_id, SSL *ssl, int use_tls, const GameOptions *options)
 {
-    // Guess from given word list
-    FILE *file = fopen("word_list.txt", "r");
-    if (file == NULL)
+    // Guess from given word list, mapped from its compiled dictionary or loaded into memory once, and map the pattern matrix and opening book if they were generated
+    Solver solver;
+    if (solver_open(&solver, WORD_LIST_FILE, DICT_FILE, PATTERN_FILE, BOOK_FILE) == -1)
     {
         error("Error opening file");
     }
-    // Get the word
-    char word[16];
-    int num_bytes;
+    solver_set_threads(&solver, options->num_threads);
+
+    // Weigh the answers by the secrets of the last snapshot, so the book and cached decisions keep applying as games are recorded
+    solver_set_prior(&solver, PRIOR_FILE);
+    solver_set_cache(&solver, CACHE_FILE);
+    solver_set_timing(&solver, TIMING_FILE);
 
     // Message received
     char *buffer;
-    buffer = (char *)malloc(262144); // Allocate memory for the buffer
-
-    // Get the hint that store the correct guess of alphabet, aka correct alphabet with correct position
-    char *hint;
-    hint = (char *)malloc(32);
-    memset(hint, '\0', 32); // Initialize the hint array to null characters
+    buffer = (char *)malloc(RESPONSE_BUFFER_SIZE); // Allocate memory for the buffer
 
-    // Collect the garbage alphabet not in the answer.
-    SimpleSet garbage_alphabets;
-    set_init(&garbage_alphabets);
+    ServerExchange server = {sockfd, ssl, use_tls, game_id, buffer};
+    GameStats stats;
+    play_rounds(&solver, options, server_exchange, &server, &stats);
 
-    // Store the message from server if the guess was correct
-    char correct_message[256];
-
-    while (fgets(word, sizeof(word), file) != NULL)
-    {
-        // Verify next word
-        if (!is_good_word_to_guess(word, hint, &garbage_alphabets))
-        {
-            continue;
-        }
-        int guess_len = 0;
-        char guess[1024];
-        word[strlen(word) - 1] = '\0';
-        sprintf(guess, "{\"type\": \"guess\", \"id\": \"%s\", \"word\": \"%s\"}\n", game_id, word);
-        guess_len = strlen(guess);
-
-        if (use_tls) // TLS handshake
-        {
-            if (SSL_write(ssl, guess, guess_len) < 0)
-            {
-
-                error("Client guess:");
-            }
-            // Receive message after guessing
-            memset(buffer, 0, 262144);
-            int result = SSL_read(ssl, buffer, 262144);
-            if (result < 0)
-            {
-                error("Cllient guessed, received from server ");
-            }
-            else
-            {
-                num_bytes = strlen(buffer);
-            }
-        }
-        else // Normal connection
-        {
-
-            if (send(sockfd, guess, guess_len, 0) == -1)
-            {
-                error("Client guessed:");
-            }
-
-            // Receive Message after guessing
-            memset(buffer, 0, 262144);
-            if ((num_bytes = recv(sockfd, buffer, 262144, 0)) == -1)
-            {
-                error("Client guessed, received from server: ");
-            }
-        }
-
-        buffer[num_bytes] = '\0';
-
-        // If guess the correct answer
-        get_message_from_json(correct_message, buffer, "type");
-        if (strcmp(correct_message, "bye") == 0)
-        {
-            char ans[64];
-            get_message_from_json(ans, buffer, "flag");
-            printf("%s\n", ans);
-            break;
-        }
-
-        // Get the hint by server
-        retreive_last_hint(buffer, hint, garbage_alphabets);
-
-        // Get the result
-        char result[1024];
-        get_message_from_json(result, buffer, "type");
-    }
-    fclose(file); // Close the file when done
-
-    cleanup_game_resources(&buffer, &hint, &garbage_alphabets);
-}
\ No newline at end of file
+    cleanup_game_resources(&buffer, &solver);
+}
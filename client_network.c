@@ -82,6 +82,66 @@ void send_hello_message(int sockfd, const char *user, char *buffer, SSL *ssl, in
     buffer[num_bytes] = '\0';
 }
 
+/**
+ * Sends a guess to the server and receives the response.
+ * The guess is wrapped in a JSON "guess" message for the given game.
+ *
+ * @param sockfd The socket file descriptor for communicating with the server.
+ * @param ssl The SSL structure for TLS communication (can be NULL for non-TLS).
+ * @param use_tls A flag indicating whether to use TLS (1 for TLS, 0 for non-TLS).
+ * @param game_id The game ID for the current session.
+ * @param word The word to guess.
+ * @param buffer A buffer to store the response received from the server.
+ * @param buffer_size The size of the buffer.
+ * @return The number of bytes received.
+ *
+ * Note: The response is null-terminated, so at most buffer_size - 1 bytes are received.
+ */
+int exchange_guess(int sockfd, SSL *ssl, int use_tls, const char *game_id, const char *word, char *buffer, int buffer_size)
+{
+    char guess[1024];
+    int guess_len = 0;
+    sprintf(guess, "{\"type\": \"guess\", \"id\": \"%s\", \"word\": \"%s\"}\n", game_id, word);
+    guess_len = strlen(guess);
+    int num_bytes = 0;
+
+    if (use_tls) // TLS handshake
+    {
+        if (SSL_write(ssl, guess, guess_len) < 0)
+        {
+            error("Client guess:");
+        }
+        // Receive message after guessing
+        memset(buffer, 0, buffer_size);
+        int result = SSL_read(ssl, buffer, buffer_size - 1);
+        if (result < 0)
+        {
+            error("Cllient guessed, received from server ");
+        }
+        else
+        {
+            num_bytes = strlen(buffer);
+        }
+    }
+    else // Normal connection
+    {
+        if (send(sockfd, guess, guess_len, 0) == -1)
+        {
+            error("Client guessed:");
+        }
+
+        // Receive Message after guessing
+        memset(buffer, 0, buffer_size);
+        if ((num_bytes = recv(sockfd, buffer, buffer_size - 1, 0)) == -1)
+        {
+            error("Client guessed, received from server: ");
+        }
+    }
+
+    buffer[num_bytes] = '\0';
+    return num_bytes;
+}
+
 /**
  * Sets up a connection to the server using the specified hostname and port number.
  * This function resolves the server's address and port, creates a socket, and establishes
@@ -8,6 +8,7 @@
 #include "client.h"
 #include <sys/socket.h>
 #include <netdb.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -27,48 +28,109 @@ void error(const char *message)
 }
 
 /*
- * Check command-line arguments and set port number, server name, and user
+ * The solver is built for one word length. If the dictionary holds words of
+ * another length, this function replaces the process with the build for that
+ * length (./client-<n>, made by make variants), passing the same arguments.
+ * The length comes from the header of the compiled dictionary, or from the
+ * word list when there is none or it is older than the word list. It returns when this build matches, or when
+ * neither can be read, in which case loading the word list reports the error. When the build for the length
+ * has not been made, it exits with an error that says so.
  */
-void check_input(int argc, char *argv[], char **port_number, char **name_of_server, char **user, int *use_tls)
+void select_word_len(char *argv[])
 {
-    if (argc < 3 || argc > 5)
+    int word_len = dict_file_word_len(DICT_FILE, WORD_LIST_FILE);
+    if (word_len == -1)
     {
-        fprintf(stderr, "Usage: ./client <-p port> <-s> <hostname> <Northeastern-username>\n");
-        exit(1);
+        word_len = dict_word_len(WORD_LIST_FILE);
     }
-
-    // Only handle 4 possible inputs, Hopefully it's Ok
-    if (argc == 3)
+    if (word_len == -1 || word_len == WORD_LEN)
     {
-        *port_number = NON_TLS_PORT;
+        return;
     }
-    else if (argc == 4)
+    char path[32];
+    snprintf(path, sizeof(path), "./client-%d", word_len);
+    if (access(path, X_OK) == -1)
     {
-        *port_number = TLS_PORT;
-        *use_tls = 1;
+        fprintf(stderr, "%s has %d-letter words, but this client is built for %d-letter words and %s is missing (make variants)\n",
+                WORD_LIST_FILE, word_len, WORD_LEN, path);
+        exit(1);
     }
-    else if (argc == 5)
+    execv(path, argv);
+    fprintf(stderr, "%s has %d-letter words and %s cannot be run: %s\n", WORD_LIST_FILE, word_len, path, strerror(errno));
+    exit(1);
+}
+
+/*
+ * Check command-line arguments and set port number, server name, user and game options
+ */
+void check_input(int argc, char *argv[], char **port_number, char **name_of_server, char **user, int *use_tls, GameOptions *options)
+{
+    *port_number = NULL;
+    options->strategy = STRATEGY_ENTROPY;
+    options->num_threads = 1;
+    options->budget_us = 0;
+    options->speculate = 1;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "p:sg:t:b:")) != -1)
     {
-        *port_number = argv[2];
-        if (strcmp(*port_number, "27994") == 0)
+        switch (opt)
         {
+        case 'p':
+            *port_number = optarg;
+            break;
+        case 's':
             *use_tls = 1;
+            break;
+        case 'g':
+            if (strategy_from_name(optarg, &options->strategy) == -1)
+            {
+                fprintf(stderr, "Unknown strategy: %s\n", optarg);
+                fprintf(stderr, USAGE);
+                exit(1);
+            }
+            break;
+        case 't':
+            options->num_threads = atoi(optarg);
+            if (options->num_threads < 0)
+            {
+                fprintf(stderr, USAGE);
+                exit(1);
+            }
+            break;
+        case 'b':
+            options->budget_us = (int)(atof(optarg) * 1000.0);
+            if (options->budget_us < 0)
+            {
+                fprintf(stderr, USAGE);
+                exit(1);
+            }
+            break;
+        default:
+            fprintf(stderr, USAGE);
+            exit(1);
         }
     }
-    else if (argc == 6)
+
+    // Exactly the hostname and the user must remain
+    if (argc - optind != 2)
     {
-        *port_number = argv[2];
-        *use_tls = 1;
+        fprintf(stderr, USAGE);
+        exit(1);
     }
-    else
+
+    if (*port_number == NULL)
     {
-        fprintf(stderr, "Usage: ./client <-p port> <-s> <hostname> <Northeastern-username>\n");
-        exit(1);
+        *port_number = *use_tls ? TLS_PORT : NON_TLS_PORT;
+    }
+    else if (strcmp(*port_number, TLS_PORT) == 0)
+    {
+        *use_tls = 1;
     }
 
     // Get the name_of_server and user
-    *name_of_server = argv[argc - 2];
-    *user = argv[argc - 1];
+    *name_of_server = argv[optind];
+    *user = argv[optind + 1];
 }
 
 /*
@@ -0,0 +1,40 @@
+/**
+ * Dictionary Compiler for the 3700.network Project - Client Word Solver
+ *
+ * This program loads the word list, encodes every word and builds the letter
+ * index, then writes the result to the compiled dictionary file the client
+ * maps at startup instead of parsing the word list (see solver_dictfile.c for
+ * the format).
+ *
+ * Usage: ./dictc <word-list> <output-file>
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+int main(int argc, char *argv[])
+{
+    const char *word_list_path = argc > 1 ? argv[1] : WORD_LIST_FILE;
+    const char *output_path = argc > 2 ? argv[2] : DICT_FILE;
+
+    Dictionary dict;
+    if (dict_load(&dict, word_list_path) == -1)
+    {
+        perror(word_list_path);
+        exit(1);
+    }
+    if (dict_check(&dict, word_list_path) == -1)
+    {
+        exit(1);
+    }
+    if (dict_write(&dict, output_path, word_list_path) == -1)
+    {
+        perror(output_path);
+        exit(1);
+    }
+    printf("%s: %d words of %d letters\n", output_path, dict.num_words, WORD_LEN);
+
+    dict_free(&dict);
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * Pattern Matrix Generator for the 3700.network Project - Client Word Solver
+ *
+ * This program computes feedback_pattern(guess, answer) for every pair of
+ * words in the word list and writes the matrix to the file the client maps at
+ * startup (see solver_matrix.c for the format).
+ *
+ * Usage: ./genpatterns <word-list> <output-file>
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+int main(int argc, char *argv[])
+{
+    const char *word_list_path = argc > 1 ? argv[1] : WORD_LIST_FILE;
+    const char *output_path = argc > 2 ? argv[2] : PATTERN_FILE;
+
+    Dictionary dict;
+    if (dict_load(&dict, word_list_path) == -1)
+    {
+        perror(word_list_path);
+        exit(1);
+    }
+    if (dict_check(&dict, word_list_path) == -1)
+    {
+        exit(1);
+    }
+    if (matrix_write(&dict, output_path) == -1)
+    {
+        perror(output_path);
+        exit(1);
+    }
+    printf("%s: %d x %d patterns\n", output_path, dict.num_words, dict.num_words);
+
+    dict_free(&dict);
+    return 0;
+}
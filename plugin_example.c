@@ -0,0 +1,68 @@
+/**
+ * Example Strategy Plugin for the 3700.network Project - Client Word Solver
+ *
+ * A strategy built as a shared object and loaded at runtime (make plugins):
+ *
+ *     ./client -g ./plugin_example.so <hostname> <Northeastern-username>
+ *
+ * It guesses the survivor that tries the most letters not guessed yet in this
+ * game, the earliest one on ties. The letters guessed so far are its per-game
+ * state, kept up to date by observe. Any file that exports a StrategyOps named
+ * STRATEGY_SYMBOL, built against the same solver.h, plugs in the same way.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+
+/**
+ * Sets up a game: no letter has been tried yet.
+ */
+static int example_init(void **state, const Solver *solver, const CandidateSet *candidates)
+{
+    (void)solver;
+    (void)candidates;
+    *state = calloc(1, sizeof(uint32_t));
+    return *state != NULL ? 0 : -1;
+}
+
+/**
+ * Adds the letters of a guess to those tried.
+ */
+static void example_observe(void *state, const Solver *solver, int guess, int pattern, const CandidateSet *candidates)
+{
+    (void)pattern;
+    (void)candidates;
+    if (guess != -1)
+    {
+        *(uint32_t *)state |= solver->dict.words[guess].mask;
+    }
+}
+
+/**
+ * Picks the survivor with the most untried letters.
+ */
+static int example_next_guess(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    (void)deadline;
+    uint32_t tried = *(uint32_t *)state;
+    int best = -1;
+    int best_fresh = -1;
+    for (int k = 0; k < candidates->count; k++)
+    {
+        int fresh = __builtin_popcount(solver->dict.words[candidates->index[k]].mask & ~tried);
+        if (fresh > best_fresh)
+        {
+            best = candidates->index[k];
+            best_fresh = fresh;
+        }
+    }
+    return best;
+}
+
+static void example_destroy(void *state)
+{
+    free(state);
+}
+
+// The decisions depend on the letters tried, not only on the survivors, so they are not shared
+const StrategyOps wordle_strategy = {STRATEGY_ABI_VERSION, 0, "example", example_init, example_observe, example_next_guess, example_destroy};
@@ -0,0 +1,604 @@
+/**
+ * Offline Game Simulator for the 3700.network Project - Client Word Solver
+ *
+ * This program plays the game locally against every n-th word of word_list.txt
+ * as the secret. It runs the client's own game loop, play_rounds(), with the
+ * server replaced by a local feedback oracle, so it measures exactly what the
+ * client would do. Games are spread over threads but each one is played on its
+ * own, so the results do not depend on the number of threads. Decisions are
+ * shared between games through the solver's decision table, as they would be
+ * by concurrent games in one client process.
+ *
+ * It reports the guess-count distribution, the failures, the wall time and the
+ * latency percentiles of the individual guess decisions.
+ *
+ * With -c, the decision cache file of earlier runs is loaded and extended, to
+ * measure a warm start as a client process would see it. With -h, answers are
+ * weighed by the secrets in a history file, and only the words of the history
+ * are played as secrets, to measure the prior on the answers it was learned from.
+ * With -b, every decision gets the time budget the client would give it. With
+ * -l, every response is delayed by a round trip, and with -s the solver decides
+ * ahead while it waits, as the client does. With -m, the decisions are broken
+ * down by the number of survivors, which is what the time model of the timed
+ * strategy is measured from (solver_timing.c), and -M writes that model to a
+ * file the client and the simulator load from TIMING_FILE. With -B, the games are played
+ * in lockstep batches, one batch at a time, and each round of a batch is
+ * decided at once (game_next_guesses()) by the -j threads as one worker pool,
+ * as a process hosting many sessions would; the time of a batched decision is
+ * split evenly between its games, and -l and -s are ignored. The endgame search has no time budget unless -e gives it one, so
+ * without -b two runs make the same decisions.
+ *
+ * Usage: ./simulate <-g first|entropy|timed|frequency|plugin.so> <-n stride> <-j threads> <-c cache-file> <-h history-file> <-b budget-ms>
+ *                   <-l latency-ms> <-s> <-m> <-M timing-file> <-B batch> <-e endgame-ms>
+ */
+
+#include "client.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * The local stand-in for the server: knows the secret and answers with its marks.
+ */
+typedef struct
+{
+    const Solver *solver;
+    int answer;     // Dictionary index of the secret word
+    int guesses;    // Guesses answered so far
+    int latency_us; // Round trip emulated for every guess
+} LocalOracle;
+
+/**
+ * Answers a guess with the marks the server would send.
+ * Gives up once the game has taken GAME_MAX_DECISIONS guesses.
+ */
+static int oracle_exchange(void *context, int guess, const char *word, int *marks, GuessRecord *history, int *num_history)
+{
+    LocalOracle *oracle = (LocalOracle *)context;
+    (void)word;
+    (void)history;
+    *num_history = 0; // The game played is the only record
+    if (oracle->latency_us > 0)
+    {
+        struct timespec rtt = {oracle->latency_us / 1000000, (long)(oracle->latency_us % 1000000) * 1000};
+        nanosleep(&rtt, NULL);
+    }
+    if (guess == oracle->answer)
+    {
+        return 1;
+    }
+    if (++oracle->guesses >= GAME_MAX_DECISIONS)
+    {
+        return -1;
+    }
+    pattern_to_marks(solver_pattern(oracle->solver, guess, oracle->answer), marks);
+    return 0;
+}
+
+/**
+ * The games shared by the simulation threads.
+ */
+typedef struct
+{
+    const Solver *solver;
+    const GameOptions *options;
+    int latency_us;     // Round trip emulated for every guess
+    const int *answers; // Dictionary index of the secret of each game
+    int num_games;
+    int next_game;    // Next game to play, taken atomically
+    int batch;        // Games played in lockstep by a thread, 0 to play them one at a time
+    GameStats *stats; // One entry per game
+} Simulation;
+
+/**
+ * Plays count games in lockstep, starting at first: every round decides the
+ * next guess of every game still running in one call.
+ */
+static void play_batch(Simulation *sim, int first, int count)
+{
+    const Solver *solver = sim->solver;
+    GameState *games = (GameState *)malloc(count * sizeof(GameState));
+    GameState **running = (GameState **)malloc(count * sizeof(GameState *));
+    int *index = (int *)malloc(count * sizeof(int));
+    int *guesses = (int *)malloc(count * sizeof(int));
+    int *computed = (int *)malloc(count * sizeof(int)); // Decisions computed by each running game before the round
+    if (games == NULL || running == NULL || index == NULL || guesses == NULL || computed == NULL)
+    {
+        perror("Error allocating a batch");
+        exit(1);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (game_init(&games[i], solver) == -1)
+        {
+            perror("Error allocating a batch");
+            exit(1);
+        }
+        memset(&sim->stats[first + i], 0, sizeof(GameStats));
+    }
+
+    for (;;)
+    {
+        int num_running = 0;
+        for (int i = 0; i < count; i++)
+        {
+            GameStats *stats = &sim->stats[first + i];
+            if (!stats->solved && stats->num_guesses < GAME_MAX_DECISIONS && games[i].candidates.count > 0)
+            {
+                index[num_running] = i;
+                running[num_running++] = &games[i];
+            }
+        }
+        if (num_running == 0)
+        {
+            break;
+        }
+
+        for (int k = 0; k < num_running; k++)
+        {
+            computed[k] = running[k]->num_computed;
+        }
+        uint64_t start = timing_now_ns();
+        game_next_guesses(running, num_running, solver, sim->options->strategy, guesses);
+        uint64_t share = (timing_now_ns() - start) / num_running;
+
+        for (int k = 0; k < num_running; k++)
+        {
+            GameState *game = running[k];
+            GameStats *stats = &sim->stats[first + index[k]];
+            stats->decision_ns[stats->num_decisions] = share;
+            stats->survivors[stats->num_decisions] = game->candidates.count;
+            stats->computed[stats->num_decisions] = game->num_computed != computed[k];
+            stats->num_decisions++;
+            stats->num_guesses++;
+            stats->game_ns += share;
+
+            int answer = sim->answers[first + index[k]];
+            if (guesses[k] == answer)
+            {
+                stats->solved = 1;
+                continue;
+            }
+            int marks[WORD_LEN];
+            pattern_to_marks(solver_pattern(solver, guesses[k], answer), marks);
+            game_observe(game, solver, solver->dict.words[guesses[k]].text, marks);
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        sim->stats[first + i].budget_hits = games[i].budget_hits;
+        game_free(&games[i]);
+    }
+    free(games);
+    free(running);
+    free(index);
+    free(guesses);
+    free(computed);
+}
+
+/**
+ * Plays games until none are left.
+ */
+static void *simulate_games(void *arg)
+{
+    Simulation *sim = (Simulation *)arg;
+    if (sim->batch > 0)
+    {
+        int first;
+        while ((first = __atomic_fetch_add(&sim->next_game, sim->batch, __ATOMIC_RELAXED)) < sim->num_games)
+        {
+            play_batch(sim, first, first + sim->batch <= sim->num_games ? sim->batch : sim->num_games - first);
+        }
+        return NULL;
+    }
+    int game;
+    while ((game = __atomic_fetch_add(&sim->next_game, 1, __ATOMIC_RELAXED)) < sim->num_games)
+    {
+        LocalOracle oracle = {sim->solver, sim->answers[game], 0, sim->latency_us};
+        play_rounds(sim->solver, sim->options, oracle_exchange, &oracle, &sim->stats[game]);
+    }
+    return NULL;
+}
+
+static int compare_ns(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Returns the p-th percentile of sorted latencies, in microseconds.
+ */
+static double percentile_us(const uint64_t *sorted, long count, double p)
+{
+    long i = (long)(p / 100.0 * (count - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+/**
+ * Returns floor(log2(survivors)), the bucket a decision is reported in.
+ */
+static int survivor_bucket(int survivors)
+{
+    return 31 - __builtin_clz((unsigned)(survivors > 0 ? survivors : 1));
+}
+
+/**
+ * Prints the decisions by floor(log2(survivors)): how many guesses the games
+ * still took from there, how long the decisions computed by the strategy took,
+ * and how much computing the rest of the game took from there. Decisions taken
+ * from the decision table are charged the mean time of their bucket, as a game
+ * played alone would have computed them.
+ * @param model The time model to update with the buckets the games reached, or NULL.
+ */
+static void print_model(const GameStats *stats, int num_games, TimingModel *model)
+{
+    long decisions[32] = {0};
+    long solved[32] = {0};
+    long guesses_left[32] = {0};
+    long computed[32] = {0};
+    double compute_us[32] = {0};
+    for (int game = 0; game < num_games; game++)
+    {
+        for (int i = 0; i < stats[game].num_decisions; i++)
+        {
+            int b = survivor_bucket(stats[game].survivors[i]);
+            decisions[b]++;
+            if (stats[game].solved)
+            {
+                solved[b]++;
+                guesses_left[b] += stats[game].num_guesses - i;
+            }
+            if (stats[game].computed[i])
+            {
+                computed[b]++;
+                compute_us[b] += stats[game].decision_ns[i] / 1000.0;
+            }
+        }
+    }
+    for (int b = 0; b < 32; b++)
+    {
+        compute_us[b] = computed[b] > 0 ? compute_us[b] / computed[b] : 0.0;
+    }
+
+    double compute_left_us[32] = {0};
+    for (int game = 0; game < num_games; game++)
+    {
+        double left = 0.0;
+        for (int i = stats[game].num_decisions - 1; i >= 0; i--)
+        {
+            int b = survivor_bucket(stats[game].survivors[i]);
+            left += compute_us[b];
+            compute_left_us[b] += left;
+        }
+    }
+
+    printf("survivors     decisions  guesses left  computed  compute us  compute left us\n");
+    for (int b = 0; b < 32; b++)
+    {
+        if (decisions[b] > 0)
+        {
+            printf("  %6d+  %12ld  %12.2f  %8ld  %10.0f  %15.0f\n", 1 << b, decisions[b],
+                   solved[b] > 0 ? (double)guesses_left[b] / solved[b] : 0.0, computed[b], compute_us[b],
+                   compute_left_us[b] / decisions[b]);
+        }
+    }
+
+    // Buckets no game reached, or where nothing was computed, keep the model's own values
+    for (int b = 0; model != NULL && b < TIMING_BUCKETS; b++)
+    {
+        if (solved[b] > 0)
+        {
+            model->guesses[b] = (double)guesses_left[b] / solved[b];
+        }
+        if (computed[b] > 0)
+        {
+            model->decision_us[b] = compute_us[b];
+            model->compute_left_us[b] = compute_left_us[b] / decisions[b];
+        }
+    }
+    if (model != NULL)
+    {
+        model->measured = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    GameOptions options = {STRATEGY_ENTROPY, 1, 0, 0};
+    int latency_us = 0;
+    int model = 0;
+    const char *timing_path = NULL;
+    int batch = 0;
+    int endgame_ms = 0;
+    int stride = 1;
+    int num_threads = 0;
+    const char *cache_path = NULL;
+    const char *history_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:n:j:c:h:b:l:smM:B:e:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'g':
+            if (strategy_from_name(optarg, &options.strategy) == -1)
+            {
+                fprintf(stderr, "Unknown strategy: %s\n", optarg);
+                exit(1);
+            }
+            break;
+        case 'n':
+            stride = atoi(optarg);
+            break;
+        case 'j':
+            num_threads = atoi(optarg);
+            break;
+        case 'c':
+            cache_path = optarg;
+            break;
+        case 'h':
+            history_path = optarg;
+            break;
+        case 'b':
+            options.budget_us = (int)(atof(optarg) * 1000.0);
+            break;
+        case 'l':
+            latency_us = (int)(atof(optarg) * 1000.0);
+            break;
+        case 's':
+            options.speculate = 1;
+            break;
+        case 'm':
+            model = 1;
+            break;
+        case 'M':
+            model = 1;
+            timing_path = optarg;
+            break;
+        case 'B':
+            batch = atoi(optarg);
+            break;
+        case 'e':
+            endgame_ms = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: ./simulate <-g first|entropy|timed|frequency|plugin.so> <-n stride> <-j threads> <-c cache-file> <-h history-file> <-b budget-ms> <-l latency-ms> <-s> <-m> <-M timing-file> <-B batch> <-e endgame-ms>\n");
+            exit(1);
+        }
+    }
+    if (stride < 1)
+    {
+        stride = 1;
+    }
+    if (num_threads < 1)
+    {
+        num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN); // One game per core
+    }
+    if (num_threads < 1)
+    {
+        num_threads = 1;
+    }
+
+    // Parallelism comes from playing games side by side, so each game scores on one thread
+    Solver solver;
+    uint64_t open_start = timing_now_ns();
+    if (solver_open(&solver, WORD_LIST_FILE, DICT_FILE, PATTERN_FILE, BOOK_FILE) == -1)
+    {
+        perror("Error opening file");
+        exit(1);
+    }
+    uint64_t open_ns = timing_now_ns() - open_start;
+    solver.endgame_budget_ms = endgame_ms > 0 ? endgame_ms : 0;
+    const Dictionary *dict = &solver.dict;
+    if (history_path != NULL && solver_set_prior(&solver, history_path) == -1)
+    {
+        perror(history_path);
+        exit(1);
+    }
+    if (cache_path != NULL && solver_set_cache(&solver, cache_path) == -1)
+    {
+        perror(cache_path);
+        exit(1);
+    }
+    solver_set_timing(&solver, TIMING_FILE);
+
+    Simulation sim;
+    sim.solver = &solver;
+    sim.options = &options;
+    sim.latency_us = latency_us;
+    sim.batch = batch > 0 ? batch : 0;
+
+    // A batch is scored by all the threads together, as one pool, so the batches are played one after the other
+    int num_players = num_threads;
+    if (sim.batch > 0)
+    {
+        solver_set_threads(&solver, num_threads);
+        num_players = 1;
+    }
+
+    // Every n-th word, or every n-th word of the history when answers are weighed by it
+    int *answers = (int *)malloc((dict->num_words > 0 ? dict->num_words : 1) * sizeof(int));
+    int num_answers = 0;
+    int num_games = 0;
+    for (int w = 0; answers != NULL && w < dict->num_words; w++)
+    {
+        if (solver.prior.weights == NULL || solver.prior.weights[w] > PRIOR_SMOOTHING)
+        {
+            if (num_answers++ % stride == 0)
+            {
+                answers[num_games++] = w;
+            }
+        }
+    }
+    sim.answers = answers;
+    sim.num_games = num_games;
+    sim.next_game = 0;
+    sim.stats = (GameStats *)calloc(sim.num_games, sizeof(GameStats));
+    pthread_t *threads = (pthread_t *)malloc(num_players * sizeof(pthread_t));
+    if (answers == NULL || sim.stats == NULL || threads == NULL)
+    {
+        perror("Error allocating games");
+        exit(1);
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int t = 1; t < num_players; t++)
+    {
+        if (pthread_create(&threads[t], NULL, simulate_games, &sim) != 0)
+        {
+            perror("Error creating thread");
+            exit(1);
+        }
+    }
+    simulate_games(&sim);
+    for (int t = 1; t < num_players; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // Summarize the games in dictionary order, so the report is the same on every run
+    int histogram[GAME_MAX_DECISIONS + 1] = {0};
+    int failures = 0;
+    long total_guesses = 0;
+    long num_decisions = 0;
+    long budget_hits = 0;
+    long speculated = 0;
+    long cheap_picks = 0;
+    uint64_t game_ns = 0;
+    uint64_t exchange_ns = 0;
+    int worst = 0;
+    int worst_answer = -1;
+    for (int game = 0; game < sim.num_games; game++)
+    {
+        const GameStats *stats = &sim.stats[game];
+        num_decisions += stats->num_decisions;
+        budget_hits += stats->budget_hits;
+        speculated += stats->speculated;
+        cheap_picks += stats->cheap_picks;
+        game_ns += stats->game_ns;
+        exchange_ns += stats->exchange_ns;
+        if (!stats->solved)
+        {
+            failures++;
+            continue;
+        }
+        histogram[stats->num_guesses]++;
+        total_guesses += stats->num_guesses;
+        if (stats->num_guesses > worst)
+        {
+            worst = stats->num_guesses;
+            worst_answer = answers[game];
+        }
+    }
+
+    uint64_t *latencies = (uint64_t *)malloc((num_decisions + 1) * sizeof(uint64_t));
+    if (latencies == NULL)
+    {
+        perror("Error allocating latencies");
+        exit(1);
+    }
+    long n = 0;
+    for (int game = 0; game < sim.num_games; game++)
+    {
+        memcpy(&latencies[n], sim.stats[game].decision_ns, sim.stats[game].num_decisions * sizeof(uint64_t));
+        n += sim.stats[game].num_decisions;
+    }
+    qsort(latencies, n, sizeof(uint64_t), compare_ns);
+
+    printf("strategy:  %s\n", strategy_name(options.strategy));
+    printf("dict:      %s (solver opened in %.3f ms)\n", solver.dict.map != NULL ? DICT_FILE : WORD_LIST_FILE, open_ns / 1e6);
+    printf("patterns:  %s\n", solver.matrix.data != NULL ? PATTERN_FILE : "computed");
+    printf("book:      %s\n", solver.book.nodes != NULL && solver.book.strategy == (uint32_t)options.strategy &&
+                                   solver.book.prior == solver.prior.checksum
+                               ? BOOK_FILE
+                               : "none");
+    if (history_path != NULL)
+    {
+        printf("prior:     %s (%d games)\n", history_path, solver.prior.num_games);
+    }
+    printf("threads:   %d%s\n", num_threads, sim.batch > 0 ? " (scoring each batch)" : "");
+    if (sim.batch > 0)
+    {
+        printf("batch:     %d games in lockstep\n", sim.batch);
+    }
+    if (solver.table != NULL)
+    {
+        uint64_t lookups, hits;
+        table_stats(solver.table, &lookups, &hits);
+        printf("table:     %llu of %llu decisions shared\n", (unsigned long long)hits, (unsigned long long)lookups);
+    }
+    if (cache_path != NULL)
+    {
+        printf("cache:     %s (%d decisions loaded)\n", cache_path, solver.cache.num_loaded);
+    }
+    printf("games:     %d (stride %d)\n", sim.num_games, stride);
+    printf("failures:  %d\n", failures);
+    if (sim.num_games > failures)
+    {
+        printf("average:   %.4f guesses\n", (double)total_guesses / (sim.num_games - failures));
+        printf("worst:     %d guesses (%s)\n", worst, dict->words[worst_answer].text);
+    }
+    for (int g = 1; g <= GAME_MAX_DECISIONS; g++)
+    {
+        if (histogram[g] > 0)
+        {
+            printf("  %2d: %d\n", g, histogram[g]);
+        }
+    }
+    if (n > 0)
+    {
+        printf("decisions: %ld (p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us)\n", n,
+               percentile_us(latencies, n, 50), percentile_us(latencies, n, 90),
+               percentile_us(latencies, n, 99), latencies[n - 1] / 1000.0);
+    }
+    if (options.budget_us > 0)
+    {
+        printf("budget:    %.3f ms, %ld decisions cut short\n", options.budget_us / 1000.0, budget_hits);
+    }
+    if (latency_us > 0)
+    {
+        printf("latency:   %.3f ms per guess\n", latency_us / 1000.0);
+    }
+    if (options.strategy == STRATEGY_TIMED)
+    {
+        printf("cheap:     %ld of %ld decisions left to first-fit\n", cheap_picks, n);
+    }
+    if (sim.num_games > 0)
+    {
+        printf("per game:  %.3f ms (%.3f ms deciding, %.3f ms waiting for responses)\n", game_ns / 1e6 / sim.num_games,
+               (game_ns - exchange_ns) / 1e6 / sim.num_games, exchange_ns / 1e6 / sim.num_games);
+    }
+    if (model)
+    {
+        // Measured from the built-in model, so a stale TIMING_FILE does not fill the buckets the run missed
+        TimingModel measured;
+        timing_init(&measured, dict);
+        print_model(sim.stats, sim.num_games, &measured);
+        if (timing_path != NULL && timing_write(&measured, dict, timing_path) == -1)
+        {
+            perror(timing_path);
+            exit(1);
+        }
+    }
+    if (options.speculate)
+    {
+        printf("speculate: %ld of %ld decisions made ahead\n", speculated, n);
+    }
+    printf("time:      %.3f s (%.3f ms per game)\n", seconds, seconds * 1000.0 / sim.num_games);
+
+    free(latencies);
+    free(threads);
+    free(sim.stats);
+    free(answers);
+    solver_close(&solver);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Solver Setup for the 3700.network Project - Client Word Solver
+ *
+ * This file loads the data shared by all strategies: the encoded dictionary,
+ * mapped from the compiled dictionary file when there is one, the precomputed
+ * pattern matrix when it has been generated, the worker pool used for parallel
+ * scoring, the opening book, and the table of decisions
+ * shared by the games of the process, which can be kept across runs in the
+ * decision cache file, and the answer prior learned from solved games.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/**
+ * Loads the dictionary and maps the pattern matrix if one is available.
+ * @param solver The solver to initialize.
+ * @param word_list_path Path of the word list.
+ * @param dict_path Path of the compiled dictionary file, or NULL to always parse the word list.
+ * @param pattern_path Path of the pattern matrix file, or NULL to compute patterns on the fly.
+ * @param book_path Path of the opening book file, or NULL to always run the strategy.
+ * @return 0 on success, -1 if the word list cannot be read or holds no WORD_LEN-letter word (errno is set).
+ *
+ * Note: A missing or stale compiled dictionary, pattern matrix or book is not an
+ * error; the word list is then parsed, patterns are computed with feedback_pattern() and every guess comes from the strategy. The caller must release the solver with solver_close().
+ */
+int solver_open(Solver *solver, const char *word_list_path, const char *dict_path, const char *pattern_path, const char *book_path)
+{
+    memset(solver, 0, sizeof(*solver));
+    solver->cache.fd = -1;
+    solver->endgame_budget_ms = ENDGAME_BUDGET_MS;
+    if ((dict_path == NULL || dict_open(&solver->dict, dict_path, word_list_path) == -1) &&
+        dict_load(&solver->dict, word_list_path) == -1)
+    {
+        return -1;
+    }
+    if (solver->dict.num_words == 0)
+    {
+        // Nothing to guess, most likely a word list of another length
+        dict_free(&solver->dict);
+        errno = EINVAL;
+        return -1;
+    }
+    if (pattern_path != NULL)
+    {
+        matrix_open(&solver->matrix, &solver->dict, pattern_path);
+    }
+    if (book_path != NULL)
+    {
+        book_open(&solver->book, &solver->dict, book_path);
+    }
+
+    // Without a table every decision is computed, which is only slower
+    solver->table = table_create(DECISION_TABLE_BITS);
+    solver->nlog2n = entropy_table_create(solver->dict.num_words);
+    timing_init(&solver->timing, &solver->dict);
+    return 0;
+}
+
+/**
+ * Sets the number of threads used to score guesses, starting the worker pool if needed.
+ * @param solver The solver.
+ * @param num_threads Number of threads (1 = calling thread only, 0 = one per online core).
+ */
+void solver_set_threads(Solver *solver, int num_threads)
+{
+    pool_destroy(solver->pool);
+    solver->pool = NULL;
+    if (num_threads != 1)
+    {
+        solver->pool = pool_create(num_threads);
+    }
+}
+
+/**
+ * Loads the decisions of earlier runs into the decision table, and keeps new ones for later runs.
+ * @param solver The solver.
+ * @param cache_path Path of the decision cache file, created if it is missing.
+ * @return The number of decisions loaded, or -1 if the file cannot be opened (errno is set).
+ *
+ * Note: Without a cache file the solver works as before, only starting cold.
+ */
+int solver_set_cache(Solver *solver, const char *cache_path)
+{
+    cache_close(&solver->cache);
+    if (solver->table == NULL)
+    {
+        return -1;
+    }
+    return cache_open(&solver->cache, &solver->dict, solver->table, cache_path);
+}
+
+/**
+ * Weighs the answers by how often they were the secret in earlier games.
+ * @param solver The solver.
+ * @param history_path Path of the history file written by history_record().
+ * @return The number of solved games in the history, or -1 if it cannot be read (errno is set).
+ *
+ * Note: The opening book and cached decisions only apply to games played with the prior they were made with.
+ */
+int solver_set_prior(Solver *solver, const char *history_path)
+{
+    prior_free(&solver->prior);
+    return prior_load(&solver->prior, &solver->dict, history_path);
+}
+
+/**
+ * Replaces the built-in time model of the timed strategy with one measured on this host.
+ * @param solver The solver.
+ * @param timing_path Path of the time model written by ./simulate -m -M.
+ * @return 0 on success, -1 if it cannot be read or was measured on another word list.
+ *
+ * Note: The built-in model, scaled to the dictionary, is kept on failure.
+ */
+int solver_set_timing(Solver *solver, const char *timing_path)
+{
+    return timing_load(&solver->timing, &solver->dict, timing_path);
+}
+
+/**
+ * Releases the dictionary, the pattern matrix, the opening book, the decision table and cache, the prior and the worker pool.
+ * @param solver The solver to release.
+ */
+void solver_close(Solver *solver)
+{
+    pool_destroy(solver->pool);
+    solver->pool = NULL;
+    cache_close(&solver->cache);
+    prior_free(&solver->prior);
+    table_destroy(solver->table);
+    solver->table = NULL;
+    free(solver->nlog2n);
+    solver->nlog2n = NULL;
+    book_close(&solver->book);
+    matrix_close(&solver->matrix);
+    dict_free(&solver->dict);
+}
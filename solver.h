@@ -0,0 +1,676 @@
+/**
+ * solver.h
+ *
+ * Header file for the word solver used by the client application of the 3700.network project.
+ * This file contains the in-memory dictionary representation and the constraint state that
+ * the game logic uses to decide which word from the word list is worth guessing next.
+ *
+ * Every dictionary word is encoded once when the word list is loaded: it carries a 26-bit
+ * letter-presence mask, its letter codes (0 = 'a' ... 25 = 'z'), and the same codes packed
+ * five bits per position into a single integer. The constraint state is expressed with the
+ * same masks, so testing a candidate word is a handful of AND/compare instructions with no
+ * hashing, string handling, or heap traffic.
+ *
+ * The constraint state follows full Wordle semantics: green (2) and yellow (1) marks narrow the
+ * letters allowed at each position, and the number of non-gray marks for a letter gives a lower
+ * bound on its occurrences in the secret. A gray (0) mark on a letter caps its occurrences at
+ * that number, which is how repeated letters are handled.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Constant definitions
+#ifndef WORD_LEN
+#define WORD_LEN 5 // The client-<n> variants are built with -DWORD_LEN=n (make variants)
+#endif
+#if WORD_LEN < 4 || WORD_LEN > 8
+#error "WORD_LEN must be between 4 and 8"
+#endif
+#define ALPHABET_SIZE 26
+#define CODE_BITS 5 // Bits per position in a packed word
+
+// 3^WORD_LEN feedback patterns
+#if WORD_LEN == 4
+#define NUM_PATTERNS 81
+#elif WORD_LEN == 5
+#define NUM_PATTERNS 243
+#elif WORD_LEN == 6
+#define NUM_PATTERNS 729
+#elif WORD_LEN == 7
+#define NUM_PATTERNS 2187
+#else
+#define NUM_PATTERNS 6561
+#endif
+#define PATTERN_SOLVED (NUM_PATTERNS - 1) // Every mark is 2
+
+#define FEEDBACK_LANES 32 // Answer blocks are padded to a multiple of the widest SIMD kernel
+#define FEEDBACK_MAX_KERNELS 3
+
+#define ENTROPY_EPSILON 1e-9 // Scores closer than this are treated as ties
+#if WORD_LEN == 5
+#define ENTROPY_OPENER "tares"  // Best entropy_best_guess() over the whole word_list.txt, without a prior
+#endif
+#define ENTROPY_FIXED_BITS 32   // Fractional bits of the fixed-point n * log2(n) table
+
+#define DEADLINE_CHECK_INTERVAL 32 // Guesses scored between two looks at the clock
+
+#define ENDGAME_MAX_CANDIDATES 50 // Survivor sets this small are searched to the end
+#define ENDGAME_PROBES 16         // Non-survivor guesses tried by the endgame search
+#define ENDGAME_BUDGET_MS 250     // Time allowed for one endgame search by default (Solver.endgame_budget_ms)
+
+#define WORD_LIST_FILE "word_list.txt"
+#define DICT_FILE "word_list.bin" // Written by ./dictc
+#define DICT_FILE_MAGIC "WDIC"
+#define DICT_FILE_VERSION 1
+#define PATTERN_FILE "patterns.bin" // Written by ./genpatterns
+#define PATTERN_FILE_MAGIC "WPAT"
+#define PATTERN_FILE_VERSION 1
+#define BOOK_FILE "book.bin" // Written by ./bookc
+#define BOOK_FILE_MAGIC "WBOK"
+#define BOOK_FILE_VERSION 3
+#define BOOK_DEFAULT_DEPTH 3 // Guesses answered by the opening book
+#define DECISION_TABLE_BITS 17  // The decision table holds 2^17 decisions (2 MB)
+#define CACHE_FILE "decisions.bin" // Decisions of earlier runs, compacted by ./cachec
+#define CACHE_FILE_MAGIC "WDEC"
+#define CACHE_FILE_VERSION 1 // Bump when a strategy changes its decisions
+#define HISTORY_FILE "history.txt" // Secrets of solved games, one per line
+#define PRIOR_FILE "prior.txt"     // Snapshot of HISTORY_FILE the prior is built from, taken by make book
+#define PRIOR_SMOOTHING 1.0        // Prior weight of a word never seen as the secret
+#define TIMING_FILE "timing.txt"   // Time model measured by ./simulate -m -M (solver_timing.c)
+#define TIMING_BUCKETS 14          // Survivor counts by floor(log2) up to 2^13, larger ones use the last bucket
+#define TIMING_REFERENCE_WORDS 15918 // Words of the list the built-in time model was measured on
+#define STRATEGY_ABI_VERSION 2         // Bump when StrategyOps or a struct it passes changes layout
+#define STRATEGY_SYMBOL "wordle_strategy" // The StrategyOps a strategy shared object exports
+#define STRATEGY_SHARED 0x1            // Decisions depend only on the survivors, so games may share them
+#define MAX_STRATEGIES 16              // Built-in and loaded strategies
+
+#define LETTER_BIT(code) (1u << (code))
+
+/**
+ * A feedback pattern as stored in the pattern matrix and kernel outputs. Up to
+ * five letters it fits in a byte, which the SIMD kernels rely on.
+ */
+#if NUM_PATTERNS <= 256
+typedef uint8_t Pattern;
+#else
+typedef uint16_t Pattern;
+#endif
+
+/**
+ * A word's letter codes packed CODE_BITS per position.
+ */
+#if WORD_LEN * CODE_BITS <= 32
+typedef uint32_t PackedWord;
+#else
+typedef uint64_t PackedWord;
+#endif
+
+/**
+ * A dictionary word together with its precomputed encodings.
+ */
+typedef struct
+{
+    char text[WORD_LEN + 1]; // Null-terminated word
+    uint8_t codes[WORD_LEN]; // Letter code per position
+    uint32_t mask;           // Bit n set if letter n appears anywhere in the word
+    PackedWord packed;       // codes[i] stored at bits [i * CODE_BITS, (i + 1) * CODE_BITS)
+} DictWord;
+
+/**
+ * Inverted index of the dictionary: one bitset (bit w = dictionary word w) per
+ * (position, letter) pair and per (letter, minimum number of copies) pair.
+ */
+typedef struct
+{
+    uint64_t *bits; // All bitsets, num_blocks 64-bit blocks each
+    int num_blocks; // Rounded up to whole 256-bit vectors
+} LetterIndex;
+
+/**
+ * The word list loaded into memory, in file order.
+ */
+typedef struct
+{
+    DictWord *words;
+    int num_words;
+    LetterIndex index;
+    uint32_t checksum; // FNV-1a hash of all words in order
+    int num_rejected;  // Lines of the word list that are not WORD_LEN-letter words
+    void *map;         // Mapping of DICT_FILE holding the words and index, NULL when they were parsed
+    size_t map_size;
+} Dictionary;
+
+/**
+ * Header of the compiled dictionary file. It is followed by num_words DictWord
+ * records, then, at index_offset, the LetterIndex bitsets. The file is mapped
+ * and used in place, so its layout is that of the structs on this host.
+ */
+typedef struct
+{
+    char magic[4];          // DICT_FILE_MAGIC
+    uint32_t version;       // DICT_FILE_VERSION
+    uint32_t word_len;      // WORD_LEN
+    uint32_t word_size;     // sizeof(DictWord)
+    uint32_t num_words;
+    uint32_t dict_checksum; // dict_checksum() of the words
+    uint32_t num_blocks;    // LetterIndex num_blocks
+    uint32_t index_offset;  // Byte offset of the letter index, a multiple of 64
+    uint64_t source_size;   // Size of the word list the file was compiled from
+    int64_t source_mtime;   // Modification time of that word list in nanoseconds
+    uint32_t reserved[4];   // Pads the header to 64 bytes
+} DictFileHeader;
+
+/**
+ * Header of the pattern matrix file. It is followed by num_words * num_words
+ * Patterns, row-major by guess: entry [g * num_words + a] is feedback_pattern(g, a).
+ */
+typedef struct
+{
+    char magic[4];          // PATTERN_FILE_MAGIC
+    uint32_t version;       // PATTERN_FILE_VERSION
+    uint32_t word_len;      // WORD_LEN
+    uint32_t num_words;     // Words in the dictionary the matrix was built from
+    uint32_t dict_checksum; // dict_checksum() of that dictionary
+    uint32_t reserved[11];  // Pads the header to 64 bytes
+} PatternFileHeader;
+
+/**
+ * The guess x answer feedback pattern matrix, mapped read-only from PATTERN_FILE.
+ */
+typedef struct
+{
+    const Pattern *data; // NULL when no matrix is loaded
+    int num_words;
+    void *map;
+    size_t map_size;
+} PatternMatrix;
+
+/**
+ * Answers packed position-major for the feedback kernels: codes[i][k] is the
+ * letter code at position i of answer k. Each array holds padded bytes.
+ */
+typedef struct
+{
+    uint8_t *codes[WORD_LEN];
+    int count;  // Number of answers
+    int padded; // count rounded up to FEEDBACK_LANES
+} AnswerBlock;
+
+typedef void (*FeedbackBlockFunction)(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns);
+
+/**
+ * A feedback kernel implementation.
+ */
+typedef struct
+{
+    const char *name;
+    FeedbackBlockFunction run;
+} FeedbackKernel;
+
+/**
+ * What the server has told us about the secret word so far.
+ */
+typedef struct
+{
+    uint32_t allowed[WORD_LEN];        // Letters that may still appear at each position
+    uint32_t required;                 // Letters the secret word must contain
+    uint32_t counted;                  // Letters whose bounds need an explicit occurrence count
+    uint8_t min_count[ALPHABET_SIZE];  // Minimum occurrences of each letter
+    uint8_t max_count[ALPHABET_SIZE];  // Maximum occurrences of each letter
+} Constraint;
+
+/**
+ * The dictionary words that are still consistent with the constraint state,
+ * stored as indexes into the dictionary in dictionary order, and as a bitset
+ * over the dictionary that is narrowed with the letter index.
+ */
+typedef struct
+{
+    int *index;
+    int count;
+    uint64_t *bits; // NULL for subsets built directly, which are narrowed word by word
+} CandidateSet;
+
+/**
+ * How the next guess is picked from the surviving candidates.
+ */
+typedef enum
+{
+    STRATEGY_FIRST_FIT, // First survivor in word list order
+    STRATEGY_ENTROPY,   // Highest expected information
+    STRATEGY_TIMED,     // Entropy, or first-fit when scoring would cost more time than it saves
+    STRATEGY_FREQUENCY, // Survivor whose letters are the most common at their positions
+    NUM_STRATEGIES      // Built-in strategies; loaded ones follow, up to MAX_STRATEGIES
+} Strategy;
+
+/**
+ * Header of the opening book file. It is followed by num_nodes BookNode records;
+ * node 0 holds the first guess of every game.
+ */
+typedef struct
+{
+    char magic[4];          // BOOK_FILE_MAGIC
+    uint32_t version;       // BOOK_FILE_VERSION
+    uint32_t word_len;      // WORD_LEN
+    uint32_t num_words;     // Words in the dictionary the book was built from
+    uint32_t dict_checksum; // dict_checksum() of that dictionary
+    uint32_t strategy;      // Strategy whose decisions the book records
+    uint32_t depth;         // Number of guesses covered
+    uint32_t num_nodes;
+    uint32_t prior;         // AnswerPrior checksum the decisions were made with, 0 for none
+    uint32_t reserved[7];   // Pads the header to 64 bytes
+} BookFileHeader;
+
+/**
+ * One game state of the opening book: the guess to send, and the states reached
+ * from it. The children are stored contiguously and sorted by pattern.
+ */
+typedef struct
+{
+    uint32_t guess;        // Dictionary index of the guess to send
+    uint32_t first_child;  // Index of the first child node
+    uint16_t num_children; // 0 for the last guess covered by the book
+    uint16_t pattern;      // Feedback pattern that leads from the parent to this node
+} BookNode;
+
+/**
+ * The opening book, mapped read-only from BOOK_FILE.
+ */
+typedef struct
+{
+    const BookNode *nodes; // NULL when no book is loaded
+    uint32_t num_nodes;
+    uint32_t strategy;
+    uint32_t prior; // AnswerPrior checksum the book was built with
+    void *map;
+    size_t map_size;
+} OpeningBook;
+
+/**
+ * Header of the decision cache file, followed by its CacheEntry records.
+ */
+typedef struct
+{
+    char magic[4];          // CACHE_FILE_MAGIC
+    uint32_t version;       // CACHE_FILE_VERSION
+    uint32_t word_len;      // WORD_LEN
+    uint32_t num_words;     // Words in the dictionary the decisions were made with
+    uint32_t dict_checksum; // dict_checksum() of that dictionary
+    uint32_t reserved[11];  // Pads the header to 64 bytes
+} CacheFileHeader;
+
+/**
+ * One decision in the cache file.
+ */
+typedef struct
+{
+    uint64_t key;   // constraint_hash() of the game state, seeded with the strategy
+    uint32_t guess; // Dictionary index of the guess
+    uint32_t check; // Detects entries that were not written completely
+} CacheEntry;
+
+/**
+ * The decision cache file, open for appending.
+ */
+typedef struct
+{
+    int fd;         // -1 when no cache file is open
+    int num_loaded; // Decisions loaded from the file at startup
+} DecisionCache;
+
+/**
+ * How likely each dictionary word is to be the secret, learned from solved games.
+ */
+typedef struct
+{
+    double *weights;   // Prior weight per dictionary word, NULL when every word is equally likely
+    uint32_t checksum; // Identifies the history the weights came from, 0 without a prior
+    int num_games;     // Solved games in the history
+} AnswerPrior;
+
+/**
+ * A point in time (CLOCK_MONOTONIC) by which a decision must be made.
+ */
+typedef struct
+{
+    uint64_t at_ns;    // 0 for no deadline
+    int expired;       // Set once a search stopped because the deadline passed
+    const int *cancel; // Set by another thread to abandon the decision, NULL if none
+} Deadline;
+
+/**
+ * A scored guess, used to pick the best one.
+ */
+typedef struct
+{
+    int guess;        // Dictionary index, -1 if none
+    double score;     // Expected information in bits
+    int is_candidate; // 1 if the guess can still be the answer
+    uint64_t cost;    // Fixed-point sum of n * log2(n) over the pattern buckets (lower is better), without a prior
+} GuessChoice;
+
+/**
+ * Private working memory of one pool worker, aligned so workers never share a cache line.
+ */
+typedef struct
+{
+    int histogram[NUM_PATTERNS]; // Feedback pattern counts of the guess being scored
+    double mass[NUM_PATTERNS];   // The same, as summed prior weights
+    GuessChoice best;            // Best guess of the worker's shard
+} __attribute__((aligned(64))) WorkerScratch;
+
+/**
+ * The cost of playing a survivor set to the end: the worst case first, then the expected case.
+ */
+typedef struct
+{
+    int depth; // Guesses needed for the worst answer
+    int total; // Guesses summed over every answer
+} EndgameCost;
+
+/**
+ * The time model of the timed strategy, by floor(log2(survivors)) (solver_timing.c).
+ */
+typedef struct
+{
+    double guesses[TIMING_BUCKETS];         // Guesses needed to finish by scoring, this one included
+    double decision_us[TIMING_BUCKETS];     // Time of one scoring decision
+    double compute_left_us[TIMING_BUCKETS]; // Time of all the scoring decisions left, this one included
+    int measured;                           // 1 if read from a TIMING_FILE, 0 for the scaled built-in model
+} TimingModel;
+
+typedef struct WorkerPool WorkerPool;
+typedef struct DecisionTable DecisionTable;
+typedef struct Speculation Speculation;
+typedef void (*PoolTask)(void *arg, int worker, int num_workers, WorkerScratch *scratch);
+
+/**
+ * Everything the strategies need: the dictionary and, if available, the pattern
+ * matrix and the worker pool used to score guesses in parallel.
+ */
+typedef struct
+{
+    Dictionary dict;
+    PatternMatrix matrix;
+    WorkerPool *pool; // NULL when scoring runs on the calling thread only
+    OpeningBook book;
+    DecisionTable *table; // Decisions shared by the games of the process, NULL when not cached
+    DecisionCache cache;  // Where new decisions are kept for later runs
+    AnswerPrior prior;
+    uint64_t *nlog2n; // Fixed-point n * log2(n) for n up to dict.num_words, NULL to score in floating point
+    int endgame_budget_ms; // Time allowed for one endgame search, 0 for no limit (reproducible decisions)
+    TimingModel timing;    // Time model of the timed strategy
+} Solver;
+
+/**
+ * The interface every strategy implements, built in or loaded from a shared
+ * object with strategy_load(). A game calls init when the strategy takes it
+ * over, observe after every response, next_guess for every decision and
+ * destroy when the game ends. Every call but next_guess may be NULL.
+ */
+typedef struct
+{
+    uint32_t abi_version; // STRATEGY_ABI_VERSION the strategy was built against
+    uint32_t flags;       // STRATEGY_SHARED or 0
+    const char *name;     // Name printed in reports
+
+    // Sets up the per-game state from the current survivors, 0 on success or -1
+    int (*init)(void **state, const Solver *solver, const CandidateSet *candidates);
+    // Reports a guess (dictionary index, -1 if not in the dictionary), its pattern and the survivors it left
+    void (*observe)(void *state, const Solver *solver, int guess, int pattern, const CandidateSet *candidates);
+    // Returns the dictionary index of the next guess, or -1 if there is none
+    int (*next_guess)(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline);
+    // Releases the per-game state
+    void (*destroy)(void *state);
+} StrategyOps;
+
+/**
+ * One guess of a game and the marks the server gave it, as listed in the
+ * "guesses" array of every server response.
+ */
+typedef struct
+{
+    char word[WORD_LEN + 1];
+    int marks[WORD_LEN];
+} GuessRecord;
+
+/**
+ * The state of one game: what the server told us, the surviving candidates and
+ * the position in the opening book.
+ */
+typedef struct
+{
+    Constraint constraint;
+    CandidateSet candidates;
+    int book_node;   // Current opening book node, -1 when the game left the book
+    int num_guesses; // Guesses observed so far
+    int budget_us;   // Time allowed per decision in microseconds, 0 for no limit
+    int budget_hits; // Decisions cut short by the time budget
+    const int *cancel; // Set by another thread to abandon the decision in progress, NULL if none
+    int num_computed;  // Decisions computed by the strategy, not taken from the book or table
+    uint64_t rtt_ns;   // Round-trip estimate, 0 until the first response
+    double speed;      // Measured scoring time over the time model's, for this host
+    int cheap_picks;   // Decisions the timed strategy left to first-fit
+    const StrategyOps *strategy_ops; // The strategy that holds strategy_state, NULL until the first decision
+    void *strategy_state;
+    int last_guess; // Dictionary index of the last guess picked for this game, -1 if none
+} GameState;
+
+// Solver
+int solver_open(Solver *solver, const char *word_list_path, const char *dict_path, const char *pattern_path, const char *book_path);
+void solver_set_threads(Solver *solver, int num_threads);
+int solver_set_cache(Solver *solver, const char *cache_path);
+int solver_set_prior(Solver *solver, const char *history_path);
+int solver_set_timing(Solver *solver, const char *timing_path);
+void solver_close(Solver *solver);
+
+// Game state
+int game_init(GameState *game, const Solver *solver);
+int game_in_book(const GameState *game, const Solver *solver, Strategy strategy);
+int game_next_guess(GameState *game, const Solver *solver, Strategy strategy);
+void game_next_guesses(GameState *const *games, int count, const Solver *solver, Strategy strategy, int *guesses);
+int game_observe(GameState *game, const Solver *solver, const char *guess, const int *marks);
+int game_rebuild(GameState *game, const Solver *solver, const GuessRecord *history, int count);
+int game_resync(GameState *game, const Solver *solver, const GuessRecord *history, int count);
+int game_copy(GameState *dest, const GameState *src, const Solver *solver);
+void game_free(GameState *game);
+
+// Time model
+uint64_t timing_now_ns(void);
+void timing_init(TimingModel *model, const Dictionary *dict);
+int timing_load(TimingModel *model, const Dictionary *dict, const char *path);
+int timing_write(const TimingModel *model, const Dictionary *dict, const char *path);
+double timing_expected_guesses(const TimingModel *model, int survivors);
+double timing_expected_compute_ns(const TimingModel *model, int survivors);
+int timing_worth_scoring(const Solver *solver, const GameState *game);
+void timing_observe_rtt(GameState *game, uint64_t ns);
+void timing_observe_decision(const TimingModel *model, GameState *game, int survivors, uint64_t ns);
+
+// Speculation
+Speculation *speculation_start(const Solver *solver, const GameState *game, Strategy strategy, int guess);
+int speculation_finish(Speculation *spec, int pattern);
+
+// Opening book
+int book_write(const Solver *solver, Strategy strategy, int depth, const char *path);
+int book_open(OpeningBook *book, const Dictionary *dict, const char *path);
+int book_child(const OpeningBook *book, int node, int pattern);
+void book_close(OpeningBook *book);
+
+// Worker pool
+WorkerPool *pool_create(int num_workers);
+void pool_run(WorkerPool *pool, PoolTask task, void *arg);
+int pool_size(const WorkerPool *pool);
+WorkerScratch *pool_scratch(WorkerPool *pool);
+void pool_destroy(WorkerPool *pool);
+
+// Decision table
+DecisionTable *table_create(int bits);
+int table_lookup(DecisionTable *table, uint64_t key);
+void table_store(DecisionTable *table, uint64_t key, int guess);
+void table_stats(const DecisionTable *table, uint64_t *lookups, uint64_t *hits);
+void table_destroy(DecisionTable *table);
+
+// Decision cache
+int cache_open(DecisionCache *cache, const Dictionary *dict, DecisionTable *table, const char *path);
+void cache_append(const DecisionCache *cache, uint64_t key, int guess);
+int cache_compact(const Dictionary *dict, const char *path, int *num_entries);
+void cache_close(DecisionCache *cache);
+
+// Answer prior
+int history_record(const char *path, const char *word);
+int prior_load(AnswerPrior *prior, const Dictionary *dict, const char *path);
+void prior_free(AnswerPrior *prior);
+
+// Decision deadlines
+void deadline_start(Deadline *deadline, int budget_us);
+void deadline_expire(Deadline *deadline);
+int deadline_passed(Deadline *deadline);
+
+// Dictionary
+int word_encode(DictWord *word, const char *text);
+int dict_load(Dictionary *dict, const char *path);
+int dict_word_len(const char *path);
+int dict_check(const Dictionary *dict, const char *path);
+void dict_free(Dictionary *dict);
+int dict_find(const Dictionary *dict, const char *text);
+uint32_t dict_checksum(const Dictionary *dict);
+uint32_t dict_words_checksum(const DictWord *words, int num_words);
+
+// Compiled dictionary
+int dict_write(const Dictionary *dict, const char *path, const char *source_path);
+int dict_open(Dictionary *dict, const char *path, const char *source_path);
+int dict_file_word_len(const char *path, const char *source_path);
+
+// Letter index
+int letter_index_blocks(int num_words);
+int letter_index_build(LetterIndex *index, const Dictionary *dict);
+void letter_index_free(LetterIndex *index);
+int letter_index_find(const LetterIndex *index, const DictWord *word);
+int letter_index_narrow(uint64_t *bits, const LetterIndex *index, const Constraint *constraint);
+uint64_t *bitset_alloc(int num_blocks);
+int bitset_count(const uint64_t *bits, int num_blocks);
+
+// Pattern matrix
+int matrix_write(const Dictionary *dict, const char *path);
+int matrix_open(PatternMatrix *matrix, const Dictionary *dict, const char *path);
+void matrix_close(PatternMatrix *matrix);
+
+// Constraint state
+void constraint_init(Constraint *constraint);
+void constraint_apply(Constraint *constraint, const char *guess, const int *marks);
+uint64_t constraint_hash(const Constraint *constraint, uint64_t seed);
+
+// Feedback patterns
+int feedback_pattern(const DictWord *guess, const DictWord *answer);
+int pattern_from_marks(const int *marks);
+void pattern_to_marks(int pattern, int *marks);
+
+// Feedback kernels
+int answer_block_init(AnswerBlock *block, const Dictionary *dict, const int *index, int count);
+void answer_block_free(AnswerBlock *block);
+void feedback_block(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns);
+void feedback_block_scalar(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns);
+int feedback_kernels(FeedbackKernel *kernels, int max);
+FeedbackKernel feedback_best_kernel(void);
+
+// Entropy strategy
+double entropy_score(const Solver *solver, int guess, const CandidateSet *candidates);
+uint64_t entropy_cost(const Solver *solver, int guess, const CandidateSet *candidates);
+uint64_t *entropy_table_create(int max);
+int entropy_best_guess(const Solver *solver, const CandidateSet *candidates, Deadline *deadline);
+int entropy_best_guesses(const Solver *solver, const CandidateSet *const *sets, int count, int *guesses);
+int entropy_best_probes(const Solver *solver, const CandidateSet *candidates, int max, int *guesses, Deadline *deadline);
+int choice_better(const GuessChoice *a, const GuessChoice *b);
+
+// Endgame search
+int endgame_best_guess(const Solver *solver, const CandidateSet *candidates, int budget_ms, Deadline *deadline, EndgameCost *cost);
+
+// Strategy selection
+int strategy_from_name(const char *name, Strategy *strategy);
+int strategy_load(const char *path, Strategy *strategy);
+const char *strategy_name(Strategy strategy);
+const StrategyOps *strategy_ops(Strategy strategy);
+uint64_t strategy_key(Strategy strategy);
+int strategy_next_guess(Strategy strategy, const Solver *solver, const CandidateSet *candidates, Deadline *deadline);
+
+// Positional frequency strategy
+int frequency_init(void **state, const Solver *solver, const CandidateSet *candidates);
+void frequency_observe(void *state, const Solver *solver, int guess, int pattern, const CandidateSet *candidates);
+int frequency_next_guess(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline);
+void frequency_destroy(void *state);
+int frequency_best_guess(const Solver *solver, const CandidateSet *candidates);
+
+// Surviving candidates
+int candidates_init(CandidateSet *candidates, const Dictionary *dict);
+int candidates_narrow(CandidateSet *candidates, const Dictionary *dict, const Constraint *constraint);
+void candidates_free(CandidateSet *candidates);
+
+/**
+ * Checks whether a dictionary word is consistent with everything learned so far.
+ * @return 1 if the word may still be the secret, 0 otherwise.
+ */
+static inline int constraint_allows(const Constraint *constraint, const DictWord *word)
+{
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        if ((constraint->allowed[i] & LETTER_BIT(word->codes[i])) == 0)
+        {
+            return 0;
+        }
+    }
+    if ((word->mask & constraint->required) != constraint->required)
+    {
+        return 0;
+    }
+
+    // Only letters with a bound stronger than "present" / "absent" need counting
+    uint32_t counted = constraint->counted & word->mask;
+    while (counted != 0)
+    {
+        int code = __builtin_ctz(counted);
+        counted &= counted - 1;
+
+        int occurrences = 0;
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            occurrences += word->codes[i] == code;
+        }
+        if (occurrences < constraint->min_count[code] || occurrences > constraint->max_count[code])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Returns the pattern row of a guess (one Pattern per answer) if the pattern matrix is loaded.
+ * @return The row, or NULL if patterns must be computed with feedback_pattern().
+ */
+static inline const Pattern *solver_pattern_row(const Solver *solver, int guess)
+{
+    if (solver->matrix.data == NULL)
+    {
+        return NULL;
+    }
+    return solver->matrix.data + (size_t)guess * solver->matrix.num_words;
+}
+
+/**
+ * Returns feedback_pattern(guess, answer), from the pattern matrix when it is loaded.
+ */
+static inline int solver_pattern(const Solver *solver, int guess, int answer)
+{
+    const Pattern *row = solver_pattern_row(solver, guess);
+    if (row != NULL)
+    {
+        return row[answer];
+    }
+    return feedback_pattern(&solver->dict.words[guess], &solver->dict.words[answer]);
+}
+
+#endif // SOLVER_H
@@ -0,0 +1,281 @@
+/**
+ * Positional Bitset Index for the 3700.network Project - Client Word Solver
+ *
+ * This file builds an inverted index over the dictionary: one bitset (one bit
+ * per word, about 2 KB for word_list.txt) for every (position, letter) pair,
+ * and one for every "contains at least k copies of letter" fact. Narrowing the
+ * surviving candidates after a response is then a short sequence of AND /
+ * ANDNOT passes over those bitsets, driven by the constraint state, followed
+ * by a popcount for the exact number of survivors. The passes use AVX2 when
+ * the CPU supports it.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BITSET_X86 1
+#include <immintrin.h>
+#endif
+
+#define ALL_LETTERS ((1u << ALPHABET_SIZE) - 1)
+
+/**
+ * Returns the bitset of words with the given letter at the given position.
+ */
+static inline const uint64_t *position_bits(const LetterIndex *index, int position, int code)
+{
+    return index->bits + (size_t)(position * ALPHABET_SIZE + code) * index->num_blocks;
+}
+
+/**
+ * Returns the bitset of words with at least the given number of copies (1 .. WORD_LEN) of a letter.
+ */
+static inline const uint64_t *at_least_bits(const LetterIndex *index, int code, int copies)
+{
+    return index->bits + (size_t)(WORD_LEN * ALPHABET_SIZE + code * WORD_LEN + copies - 1) * index->num_blocks;
+}
+
+/**
+ * Allocates a zeroed bitset covering num_blocks 64-bit blocks, aligned for AVX2.
+ */
+uint64_t *bitset_alloc(int num_blocks)
+{
+    uint64_t *bits = NULL;
+    if (posix_memalign((void **)&bits, 32, (size_t)num_blocks * sizeof(uint64_t)) != 0)
+    {
+        return NULL;
+    }
+    memset(bits, 0, (size_t)num_blocks * sizeof(uint64_t));
+    return bits;
+}
+
+/**
+ * Returns the number of 64-bit blocks in each bitset of a letter index.
+ * @param num_words The number of words in the dictionary.
+ * @return The block count, rounded up to whole 256-bit vectors so the AVX2 passes need no tail handling.
+ */
+int letter_index_blocks(int num_words)
+{
+    int num_blocks = (num_words + 255) / 256 * 4;
+    return num_blocks > 0 ? num_blocks : 4;
+}
+
+/**
+ * Builds the letter index of a dictionary.
+ * @param index The index to fill in.
+ * @param dict The loaded dictionary.
+ * @return 0 on success, -1 if the bitsets cannot be allocated. The index is then empty.
+ *
+ * Note: The caller must release the index with letter_index_free().
+ */
+int letter_index_build(LetterIndex *index, const Dictionary *dict)
+{
+    index->num_blocks = letter_index_blocks(dict->num_words);
+    int num_bitsets = WORD_LEN * ALPHABET_SIZE + ALPHABET_SIZE * WORD_LEN;
+    index->bits = bitset_alloc(num_bitsets * index->num_blocks);
+    if (index->bits == NULL)
+    {
+        index->num_blocks = 0;
+        return -1;
+    }
+
+    for (int w = 0; w < dict->num_words; w++)
+    {
+        const DictWord *word = &dict->words[w];
+        uint64_t bit = 1ull << (w % 64);
+        int block = w / 64;
+        int copies[ALPHABET_SIZE] = {0};
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            int code = word->codes[i];
+            ((uint64_t *)position_bits(index, i, code))[block] |= bit;
+            copies[code]++;
+            ((uint64_t *)at_least_bits(index, code, copies[code]))[block] |= bit;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Finds a word through the index: the word with its letters at every position
+ * is in the AND of their position bitsets.
+ * @param index The letter index.
+ * @param word The encoded word to look for.
+ * @return Dictionary index of the first matching word, or -1 if there is none.
+ */
+int letter_index_find(const LetterIndex *index, const DictWord *word)
+{
+    for (int b = 0; b < index->num_blocks; b++)
+    {
+        uint64_t match = ~0ull;
+        for (int i = 0; i < WORD_LEN && match != 0; i++)
+        {
+            match &= position_bits(index, i, word->codes[i])[b];
+        }
+        if (match != 0)
+        {
+            return b * 64 + __builtin_ctzll(match);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Releases the memory held by a letter index.
+ * @param index The index to free.
+ */
+void letter_index_free(LetterIndex *index)
+{
+    free(index->bits);
+    index->bits = NULL;
+    index->num_blocks = 0;
+}
+
+static void and_scalar(uint64_t *dst, const uint64_t *src, int num_blocks)
+{
+    for (int b = 0; b < num_blocks; b++)
+    {
+        dst[b] &= src[b];
+    }
+}
+
+static void andnot_scalar(uint64_t *dst, const uint64_t *src, int num_blocks)
+{
+    for (int b = 0; b < num_blocks; b++)
+    {
+        dst[b] &= ~src[b];
+    }
+}
+
+#ifdef BITSET_X86
+
+__attribute__((target("avx2"))) static void and_avx2(uint64_t *dst, const uint64_t *src, int num_blocks)
+{
+    for (int b = 0; b < num_blocks; b += 4)
+    {
+        __m256i d = _mm256_load_si256((const __m256i *)(dst + b));
+        __m256i s = _mm256_load_si256((const __m256i *)(src + b));
+        _mm256_store_si256((__m256i *)(dst + b), _mm256_and_si256(d, s));
+    }
+}
+
+__attribute__((target("avx2"))) static void andnot_avx2(uint64_t *dst, const uint64_t *src, int num_blocks)
+{
+    for (int b = 0; b < num_blocks; b += 4)
+    {
+        __m256i d = _mm256_load_si256((const __m256i *)(dst + b));
+        __m256i s = _mm256_load_si256((const __m256i *)(src + b));
+        _mm256_store_si256((__m256i *)(dst + b), _mm256_andnot_si256(s, d));
+    }
+}
+
+#endif // BITSET_X86
+
+typedef void (*BitsetPass)(uint64_t *dst, const uint64_t *src, int num_blocks);
+
+/**
+ * Resolves the AND / ANDNOT passes once for this CPU.
+ */
+static void bitset_passes(BitsetPass *and_pass, BitsetPass *andnot_pass)
+{
+    static BitsetPass resolved_and = NULL;
+    static BitsetPass resolved_andnot = NULL;
+    BitsetPass run_and = __atomic_load_n(&resolved_and, __ATOMIC_RELAXED);
+    BitsetPass run_andnot = __atomic_load_n(&resolved_andnot, __ATOMIC_RELAXED);
+    if (run_and == NULL || run_andnot == NULL)
+    {
+        run_and = and_scalar;
+        run_andnot = andnot_scalar;
+#ifdef BITSET_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            run_and = and_avx2;
+            run_andnot = andnot_avx2;
+        }
+#endif
+        __atomic_store_n(&resolved_andnot, run_andnot, __ATOMIC_RELAXED);
+        __atomic_store_n(&resolved_and, run_and, __ATOMIC_RELAXED);
+    }
+    *and_pass = run_and;
+    *andnot_pass = run_andnot;
+}
+
+/**
+ * Counts the bits set in a bitset.
+ */
+int bitset_count(const uint64_t *bits, int num_blocks)
+{
+    int count = 0;
+    for (int b = 0; b < num_blocks; b++)
+    {
+        count += __builtin_popcountll(bits[b]);
+    }
+    return count;
+}
+
+/**
+ * Clears the words of a bitset that the constraint state rules out.
+ * @param bits The bitset to narrow (one bit per dictionary word).
+ * @param index The letter index of the dictionary.
+ * @param constraint The constraint state.
+ * @return The number of words left in the bitset.
+ */
+int letter_index_narrow(uint64_t *bits, const LetterIndex *index, const Constraint *constraint)
+{
+    BitsetPass and_pass, andnot_pass;
+    bitset_passes(&and_pass, &andnot_pass);
+    int n = index->num_blocks;
+
+    // Letters known to be absent are removed once, not per position
+    uint32_t absent = 0;
+    for (int code = 0; code < ALPHABET_SIZE; code++)
+    {
+        if (constraint->max_count[code] == 0)
+        {
+            absent |= LETTER_BIT(code);
+            andnot_pass(bits, at_least_bits(index, code, 1), n);
+        }
+    }
+
+    // Positions: keep the known letter, or drop the letters ruled out there
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        uint32_t allowed = constraint->allowed[i];
+        if (allowed != 0 && (allowed & (allowed - 1)) == 0)
+        {
+            and_pass(bits, position_bits(index, i, __builtin_ctz(allowed)), n);
+            continue;
+        }
+        uint32_t ruled_out = ~allowed & ALL_LETTERS & ~absent;
+        while (ruled_out != 0)
+        {
+            int code = __builtin_ctz(ruled_out);
+            ruled_out &= ruled_out - 1;
+            andnot_pass(bits, position_bits(index, i, code), n);
+        }
+    }
+
+    // Occurrence bounds
+    uint32_t required = constraint->required;
+    while (required != 0)
+    {
+        int code = __builtin_ctz(required);
+        required &= required - 1;
+        and_pass(bits, at_least_bits(index, code, constraint->min_count[code]), n);
+    }
+    uint32_t capped = constraint->counted & ~absent;
+    while (capped != 0)
+    {
+        int code = __builtin_ctz(capped);
+        capped &= capped - 1;
+        if (constraint->max_count[code] < WORD_LEN)
+        {
+            andnot_pass(bits, at_least_bits(index, code, constraint->max_count[code] + 1), n);
+        }
+    }
+
+    return bitset_count(bits, n);
+}
@@ -0,0 +1,334 @@
+/**
+ * Opening Book Functions for the 3700.network Project - Client Word Solver
+ *
+ * The first few guesses of a game depend only on the feedback seen so far, so
+ * they are the same in every game that sees the same feedback. This file
+ * compiles those decisions once into a decision tree keyed by the sequence of
+ * feedback patterns, and stores it in a compact versioned file (see
+ * BookFileHeader and BookNode in solver.h). During a game the next guess is
+ * then a lookup while the game is still inside the tree.
+ *
+ * The tree is written breadth first, so the children of every node are
+ * contiguous and sorted by pattern.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * A node waiting to be expanded while the book is built.
+ */
+typedef struct
+{
+    CandidateSet candidates; // Answers still possible at this node
+    int depth;               // 1 for the first guess
+} PendingNode;
+
+/**
+ * Fills in the header describing a dictionary, strategy and tree.
+ */
+static void book_header(BookFileHeader *header, const Dictionary *dict, Strategy strategy, int depth, uint32_t num_nodes,
+                        uint32_t prior)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, BOOK_FILE_MAGIC, sizeof(header->magic));
+    header->version = BOOK_FILE_VERSION;
+    header->word_len = WORD_LEN;
+    header->num_words = (uint32_t)dict->num_words;
+    header->dict_checksum = dict_checksum(dict);
+    header->strategy = (uint32_t)strategy;
+    header->depth = (uint32_t)depth;
+    header->num_nodes = num_nodes;
+    header->prior = prior;
+}
+
+/**
+ * Releases the answers of the nodes not expanded yet, and the nodes.
+ */
+static void pending_free(PendingNode *pending, int from, int num_nodes)
+{
+    for (int n = from; n < num_nodes; n++)
+    {
+        candidates_free(&pending[n].candidates);
+    }
+    free(pending);
+}
+
+/**
+ * Computes the decisions of a strategy for the first guesses of every game and writes them to a file.
+ * @param solver The solver used to make the decisions.
+ * @param strategy The strategy whose decisions are recorded.
+ * @param depth Number of guesses to cover (1 = only the first guess).
+ * @param path Path of the file to write.
+ * @return The number of nodes written, or -1 on failure (errno is set), also
+ *         when out of memory or when the strategy makes no decision for a node.
+ *
+ * Note: Only built-in strategies whose decisions can be shared get a book;
+ * a loaded strategy's number depends on the command line it was loaded from.
+ */
+int book_write(const Solver *solver, Strategy strategy, int depth, const char *path)
+{
+    if (strategy >= NUM_STRATEGIES || !(strategy_ops(strategy)->flags & STRATEGY_SHARED))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    const Dictionary *dict = &solver->dict;
+    int capacity = 1024;
+    int num_nodes = 1;
+    BookNode *nodes = (BookNode *)calloc(capacity, sizeof(BookNode));
+    PendingNode *pending = (PendingNode *)calloc(capacity, sizeof(PendingNode));
+    if (nodes == NULL || pending == NULL)
+    {
+        free(nodes);
+        free(pending);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (candidates_init(&pending[0].candidates, dict) == -1)
+    {
+        pending_free(pending, 0, 1);
+        free(nodes);
+        errno = ENOMEM;
+        return -1;
+    }
+    pending[0].depth = 1;
+
+    for (int n = 0; n < num_nodes; n++)
+    {
+        CandidateSet *candidates = &pending[n].candidates;
+        int guess = strategy_next_guess(strategy, solver, candidates, NULL);
+        if (guess < 0 || guess >= dict->num_words)
+        {
+            // A book that sends no guess would leave every game that reaches the node without one
+            pending_free(pending, n, num_nodes);
+            free(nodes);
+            errno = EINVAL;
+            return -1;
+        }
+        nodes[n].guess = (uint32_t)guess;
+        nodes[n].first_child = (uint32_t)num_nodes;
+
+        if (pending[n].depth < depth && candidates->count > 1)
+        {
+            // Split the answers by the feedback they give to the guess
+            int histogram[NUM_PATTERNS] = {0};
+            for (int i = 0; i < candidates->count; i++)
+            {
+                histogram[solver_pattern(solver, guess, candidates->index[i])]++;
+            }
+
+            int child_of_pattern[NUM_PATTERNS];
+            for (int p = 0; p < NUM_PATTERNS; p++)
+            {
+                child_of_pattern[p] = -1;
+                if (histogram[p] == 0 || p == PATTERN_SOLVED)
+                {
+                    continue;
+                }
+                if (num_nodes == capacity)
+                {
+                    BookNode *grown_nodes = (BookNode *)realloc(nodes, 2 * capacity * sizeof(BookNode));
+                    if (grown_nodes != NULL)
+                    {
+                        nodes = grown_nodes;
+                    }
+                    PendingNode *grown_pending = (PendingNode *)realloc(pending, 2 * capacity * sizeof(PendingNode));
+                    if (grown_pending != NULL)
+                    {
+                        pending = grown_pending;
+                    }
+                    if (grown_nodes == NULL || grown_pending == NULL)
+                    {
+                        pending_free(pending, n, num_nodes);
+                        free(nodes);
+                        errno = ENOMEM;
+                        return -1;
+                    }
+                    capacity *= 2;
+                    candidates = &pending[n].candidates;
+                }
+                int child = num_nodes;
+                memset(&nodes[child], 0, sizeof(BookNode));
+                nodes[child].pattern = (uint16_t)p;
+                pending[child].depth = pending[n].depth + 1;
+                pending[child].candidates.index = (int *)malloc(histogram[p] * sizeof(int));
+                pending[child].candidates.count = 0;
+                pending[child].candidates.bits = NULL;
+                if (pending[child].candidates.index == NULL)
+                {
+                    pending_free(pending, n, num_nodes);
+                    free(nodes);
+                    errno = ENOMEM;
+                    return -1;
+                }
+                num_nodes++;
+                child_of_pattern[p] = child;
+                nodes[n].num_children++;
+            }
+
+            // Distribute the answers, keeping dictionary order
+            for (int i = 0; i < candidates->count; i++)
+            {
+                int child = child_of_pattern[solver_pattern(solver, guess, candidates->index[i])];
+                if (child >= 0)
+                {
+                    CandidateSet *subset = &pending[child].candidates;
+                    subset->index[subset->count++] = candidates->index[i];
+                }
+            }
+        }
+        candidates_free(&pending[n].candidates);
+    }
+    free(pending);
+
+    int result = -1;
+    FILE *file = fopen(path, "wb");
+    if (file != NULL)
+    {
+        BookFileHeader header;
+        book_header(&header, dict, strategy, depth, (uint32_t)num_nodes, solver->prior.checksum);
+        result = num_nodes;
+        if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+            fwrite(nodes, sizeof(BookNode), num_nodes, file) != (size_t)num_nodes)
+        {
+            result = -1;
+        }
+        if (fclose(file) != 0)
+        {
+            result = -1;
+        }
+    }
+    free(nodes);
+    return result;
+}
+
+/**
+ * Returns 1 if every node of a mapped book sends a dictionary word and its
+ * children are nodes of the book, so following it never leaves the mapping.
+ */
+static int nodes_valid(const BookNode *nodes, uint32_t num_nodes, uint32_t num_words)
+{
+    for (uint32_t n = 0; n < num_nodes; n++)
+    {
+        if (nodes[n].guess >= num_words || nodes[n].pattern >= NUM_PATTERNS ||
+            (nodes[n].num_children > 0 &&
+             (nodes[n].first_child >= num_nodes || nodes[n].num_children > num_nodes - nodes[n].first_child)))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Maps an opening book file read-only.
+ * @param book The book to fill in. Its nodes are NULL if the file cannot be used.
+ * @param dict The loaded dictionary the book must match.
+ * @param path Path of the book file.
+ * @return 0 on success, -1 if the file is missing, does not match the dictionary
+ *         or has a node that is out of range.
+ */
+int book_open(OpeningBook *book, const Dictionary *dict, const char *path)
+{
+    memset(book, 0, sizeof(*book));
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1 || (size_t)info.st_size < sizeof(BookFileHeader))
+    {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)info.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    const BookFileHeader *header = (const BookFileHeader *)map;
+    BookFileHeader expected;
+    book_header(&expected, dict, (Strategy)header->strategy, (int)header->depth, header->num_nodes, header->prior);
+    if (memcmp(header, &expected, sizeof(expected)) != 0 ||
+        size != sizeof(BookFileHeader) + (size_t)header->num_nodes * sizeof(BookNode) ||
+        header->num_nodes == 0)
+    {
+        fprintf(stderr, "Ignoring %s: built for another version or word list\n", path);
+        munmap(map, size);
+        return -1;
+    }
+    if (!nodes_valid((const BookNode *)((const char *)map + sizeof(BookFileHeader)), header->num_nodes, header->num_words))
+    {
+        fprintf(stderr, "Ignoring %s: a node is out of range\n", path);
+        munmap(map, size);
+        return -1;
+    }
+
+    book->map = map;
+    book->map_size = size;
+    book->nodes = (const BookNode *)((const char *)map + sizeof(BookFileHeader));
+    book->num_nodes = header->num_nodes;
+    book->strategy = header->strategy;
+    book->prior = header->prior;
+    return 0;
+}
+
+/**
+ * Follows the edge of a node for a feedback pattern.
+ * @param book The opening book.
+ * @param node The current node.
+ * @param pattern The feedback pattern received for the node's guess.
+ * @return The child node, or -1 if the book does not cover that state.
+ */
+int book_child(const OpeningBook *book, int node, int pattern)
+{
+    const BookNode *parent = &book->nodes[node];
+    int lo = (int)parent->first_child;
+    int hi = lo + parent->num_children;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (book->nodes[mid].pattern < pattern)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo < (int)parent->first_child + parent->num_children && book->nodes[lo].pattern == pattern)
+    {
+        return lo;
+    }
+    return -1;
+}
+
+/**
+ * Unmaps an opening book.
+ * @param book The book to release.
+ */
+void book_close(OpeningBook *book)
+{
+    if (book->map != NULL)
+    {
+        munmap(book->map, book->map_size);
+    }
+    memset(book, 0, sizeof(*book));
+}
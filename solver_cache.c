@@ -0,0 +1,333 @@
+/**
+ * Decision Cache Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file keeps the decisions of the decision table (solver_table.c) across
+ * processes. The cache file is a versioned header followed by fixed-size
+ * (constraint hash, guess) entries (see CacheFileHeader and CacheEntry in
+ * solver.h). At startup the file is mapped and every entry is loaded into the
+ * table; every decision computed afterwards is appended to it.
+ *
+ * Appends are single write() calls on a file opened with O_APPEND, so any
+ * number of client processes can share one cache file. A decision made again
+ * by another process is simply appended twice, and cache_compact() rewrites
+ * the file with one entry per key. Compaction replaces the file, so appends to
+ * the old one would be lost: every process holds a shared flock() on the file
+ * while it has it open, and compaction takes an exclusive one, so it refuses
+ * to run while a client is using the file.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Fills in the header describing a dictionary.
+ */
+static void cache_header(CacheFileHeader *header, const Dictionary *dict)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, CACHE_FILE_MAGIC, sizeof(header->magic));
+    header->version = CACHE_FILE_VERSION;
+    header->word_len = WORD_LEN;
+    header->num_words = (uint32_t)dict->num_words;
+    header->dict_checksum = dict_checksum(dict);
+}
+
+/**
+ * Returns the integrity check of an entry, so a torn or foreign entry is not loaded.
+ */
+static uint32_t entry_check(uint64_t key, uint32_t guess)
+{
+    return (uint32_t)(key >> 32) ^ (uint32_t)key ^ (guess * 2654435761u);
+}
+
+/**
+ * Maps a cache file and checks that it was written for the dictionary.
+ * @param size Receives the size of the mapping.
+ * @param num_entries Receives the number of whole entries in the file.
+ * @return The mapping, or NULL if the file is missing, unreadable or stale.
+ */
+static void *cache_map(const Dictionary *dict, const char *path, size_t *size, size_t *num_entries)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1 || (size_t)info.st_size < sizeof(CacheFileHeader))
+    {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)info.st_size;
+    void *map = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    CacheFileHeader expected;
+    cache_header(&expected, dict);
+    if (memcmp(map, &expected, sizeof(expected)) != 0)
+    {
+        munmap(map, *size);
+        return NULL;
+    }
+
+    // An entry cut short by a crash at the end of the file is ignored
+    *num_entries = (*size - sizeof(CacheFileHeader)) / sizeof(CacheEntry);
+    return map;
+}
+
+/**
+ * Returns 1 if a path still names the file open on a descriptor, 0 once it has been replaced.
+ */
+static int still_linked(int fd, const char *path)
+{
+    struct stat open_file, named;
+    return fstat(fd, &open_file) == 0 && stat(path, &named) == 0 && open_file.st_dev == named.st_dev &&
+           open_file.st_ino == named.st_ino;
+}
+
+/**
+ * Opens a cache file for appending under a shared lock, waiting for a running compaction.
+ * @return The descriptor, or -1 on failure (errno is set).
+ */
+static int open_locked(const char *path)
+{
+    for (;;)
+    {
+        int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd == -1)
+        {
+            return -1;
+        }
+        if (flock(fd, LOCK_SH) == -1)
+        {
+            close(fd);
+            return -1;
+        }
+        if (still_linked(fd, path))
+        {
+            return fd;
+        }
+        // Compacted while we waited, so the decisions go to the file that replaced it
+        close(fd);
+    }
+}
+
+/**
+ * Opens a cache file, loads its decisions into a table and prepares it for appending.
+ * @param cache The cache to open.
+ * @param dict The dictionary the decisions refer to.
+ * @param table The table that receives the decisions.
+ * @param path Path of the cache file, created if it is missing.
+ * @return The number of decisions loaded, or -1 on failure (errno is set).
+ *
+ * Note: A cache file written for another word list or version is started over.
+ * Waits while the file is being compacted. The caller must release the cache
+ * with cache_close(), which lets the file be compacted again.
+ */
+int cache_open(DecisionCache *cache, const Dictionary *dict, DecisionTable *table, const char *path)
+{
+    cache->fd = -1;
+    cache->num_loaded = 0;
+
+    size_t size = 0;
+    size_t num_entries = 0;
+    void *map = cache_map(dict, path, &size, &num_entries);
+    if (map != NULL)
+    {
+        const CacheEntry *entries = (const CacheEntry *)((const char *)map + sizeof(CacheFileHeader));
+        for (size_t i = 0; i < num_entries; i++)
+        {
+            if (entries[i].check == entry_check(entries[i].key, entries[i].guess) &&
+                entries[i].guess < (uint32_t)dict->num_words)
+            {
+                table_store(table, entries[i].key, (int)entries[i].guess);
+                cache->num_loaded++;
+            }
+        }
+        munmap(map, size);
+    }
+
+    int fd = open_locked(path);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    if (map == NULL)
+    {
+        // Missing or stale: start over with a fresh header
+        CacheFileHeader header;
+        cache_header(&header, dict);
+        if (ftruncate(fd, 0) == -1 || write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header))
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    cache->fd = fd;
+    return cache->num_loaded;
+}
+
+/**
+ * Appends a decision to the cache file.
+ * @param cache The cache.
+ * @param key The constraint_hash() key of the decision.
+ * @param guess Dictionary index of the guess.
+ */
+void cache_append(const DecisionCache *cache, uint64_t key, int guess)
+{
+    if (cache->fd == -1)
+    {
+        return;
+    }
+    CacheEntry entry = {key, (uint32_t)guess, entry_check(key, (uint32_t)guess)};
+    if (write(cache->fd, &entry, sizeof(entry)) != (ssize_t)sizeof(entry))
+    {
+        // Losing a decision only costs computing it again
+        return;
+    }
+}
+
+/**
+ * Compares entries by key, then by position in the file.
+ */
+static int compare_entries(const void *a, const void *b)
+{
+    const CacheEntry *x = *(const CacheEntry *const *)a;
+    const CacheEntry *y = *(const CacheEntry *const *)b;
+    if (x->key != y->key)
+    {
+        return x->key < y->key ? -1 : 1;
+    }
+    return (x > y) - (x < y);
+}
+
+/**
+ * Compacts a cache file once no process can append to it (see cache_compact()).
+ */
+static int compact_locked(const Dictionary *dict, const char *path, int *num_entries)
+{
+    size_t size = 0;
+    size_t count = 0;
+    void *map = cache_map(dict, path, &size, &count);
+    if (map == NULL)
+    {
+        return -1;
+    }
+    const CacheEntry *entries = (const CacheEntry *)((const char *)map + sizeof(CacheFileHeader));
+
+    // Sort pointers, so entries of the same key stay in file order
+    const CacheEntry **sorted = (const CacheEntry **)malloc((count > 0 ? count : 1) * sizeof(CacheEntry *));
+    if (sorted == NULL)
+    {
+        munmap(map, size);
+        return -1;
+    }
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (entries[i].check == entry_check(entries[i].key, entries[i].guess) &&
+            entries[i].guess < (uint32_t)dict->num_words)
+        {
+            sorted[valid++] = &entries[i];
+        }
+    }
+    qsort(sorted, valid, sizeof(CacheEntry *), compare_entries);
+
+    char tmp_path[4096];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *file = fopen(tmp_path, "wb");
+    if (file == NULL)
+    {
+        free(sorted);
+        munmap(map, size);
+        return -1;
+    }
+    CacheFileHeader header;
+    cache_header(&header, dict);
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    int kept = 0;
+    for (size_t i = 0; i < valid && ok; i++)
+    {
+        // The last entry of a run of equal keys is the latest decision
+        if (i + 1 < valid && sorted[i + 1]->key == sorted[i]->key)
+        {
+            continue;
+        }
+        ok = fwrite(sorted[i], sizeof(CacheEntry), 1, file) == 1;
+        kept++;
+    }
+    free(sorted);
+    munmap(map, size);
+
+    if (fclose(file) != 0 || !ok || rename(tmp_path, path) == -1)
+    {
+        unlink(tmp_path);
+        return -1;
+    }
+    if (num_entries != NULL)
+    {
+        *num_entries = (int)count;
+    }
+    return kept;
+}
+
+/**
+ * Rewrites a cache file with one entry per key, keeping the latest decision.
+ * The compacted file replaces the old one atomically.
+ * @param dict The dictionary the decisions refer to.
+ * @param path Path of the cache file.
+ * @param num_entries If not NULL, receives the number of entries in the file before compaction.
+ * @return The number of entries kept, or -1 on failure (errno is set). errno is
+ *         EWOULDBLOCK when a process has the file open with cache_open().
+ *
+ * Note: Clients that start while the file is compacted wait in cache_open()
+ * and then append to the compacted file.
+ */
+int cache_compact(const Dictionary *dict, const char *path, int *num_entries)
+{
+    int lock_fd = open(path, O_RDONLY);
+    if (lock_fd == -1)
+    {
+        return -1;
+    }
+    if (flock(lock_fd, LOCK_EX | LOCK_NB) == -1)
+    {
+        int lock_errno = errno;
+        close(lock_fd);
+        errno = lock_errno;
+        return -1;
+    }
+    int kept = compact_locked(dict, path, num_entries);
+    int compact_errno = errno;
+    close(lock_fd); // Releases the lock, after the compacted file has replaced the old one
+    errno = compact_errno;
+    return kept;
+}
+
+/**
+ * Closes the cache file.
+ * @param cache The cache to close.
+ */
+void cache_close(DecisionCache *cache)
+{
+    if (cache->fd != -1)
+    {
+        close(cache->fd);
+        cache->fd = -1;
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * Candidate Set Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file maintains the list of dictionary words that are still consistent
+ * with everything the server has told us. The list starts as the whole
+ * dictionary and is narrowed after every response. The narrowing runs on the
+ * survivor bitset with the letter index (solver_bitset.c), so its cost is a
+ * few bitset passes rather than a test per word; the index array is then
+ * rebuilt from the surviving bits for the strategies.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+
+/**
+ * Initializes a candidate set containing every dictionary word.
+ * @param candidates The candidate set to initialize.
+ * @param dict The loaded dictionary.
+ * @return 0 on success, -1 if the index cannot be allocated. The set is then empty.
+ *
+ * Note: The caller must release the candidate set with candidates_free(), in either case.
+ */
+int candidates_init(CandidateSet *candidates, const Dictionary *dict)
+{
+    candidates->index = (int *)malloc((dict->num_words > 0 ? dict->num_words : 1) * sizeof(int));
+    candidates->bits = NULL;
+    candidates->count = 0;
+    if (candidates->index == NULL)
+    {
+        return -1;
+    }
+    candidates->count = dict->num_words;
+    for (int i = 0; i < dict->num_words; i++)
+    {
+        candidates->index[i] = i;
+    }
+
+    candidates->bits = bitset_alloc(dict->index.num_blocks);
+    if (candidates->bits != NULL)
+    {
+        for (int i = 0; i < dict->num_words; i++)
+        {
+            candidates->bits[i / 64] |= 1ull << (i % 64);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Removes the candidates that are no longer allowed by the constraint state.
+ * The surviving indexes keep their relative (dictionary) order.
+ * @param candidates The candidate set to narrow.
+ * @param dict The dictionary the indexes refer to.
+ * @param constraint The current constraint state.
+ * @return The number of surviving candidates.
+ */
+int candidates_narrow(CandidateSet *candidates, const Dictionary *dict, const Constraint *constraint)
+{
+    if (candidates->bits != NULL && dict->index.bits != NULL)
+    {
+        candidates->count = letter_index_narrow(candidates->bits, &dict->index, constraint);
+
+        // Rebuild the index array from the surviving bits
+        int kept = 0;
+        for (int b = 0; b < dict->index.num_blocks && kept < candidates->count; b++)
+        {
+            uint64_t block = candidates->bits[b];
+            while (block != 0)
+            {
+                candidates->index[kept++] = b * 64 + __builtin_ctzll(block);
+                block &= block - 1;
+            }
+        }
+        return candidates->count;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < candidates->count; i++)
+    {
+        int w = candidates->index[i];
+        if (constraint_allows(constraint, &dict->words[w]))
+        {
+            candidates->index[kept++] = w;
+        }
+    }
+    candidates->count = kept;
+    return kept;
+}
+
+/**
+ * Releases the memory held by a candidate set.
+ * @param candidates The candidate set to free.
+ */
+void candidates_free(CandidateSet *candidates)
+{
+    free(candidates->index);
+    free(candidates->bits);
+    candidates->index = NULL;
+    candidates->bits = NULL;
+    candidates->count = 0;
+}
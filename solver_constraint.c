@@ -0,0 +1,124 @@
+/**
+ * Constraint State Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file folds the marks returned by the server for a guess into the
+ * mask-based constraint state declared in solver.h. Each response narrows the
+ * per-position allowed letters, adds letters the secret must contain, and
+ * tightens the minimum/maximum occurrence count of every guessed letter.
+ */
+
+#include "solver.h"
+#include <string.h>
+
+#define ALL_LETTERS ((1u << ALPHABET_SIZE) - 1)
+
+/**
+ * Resets a constraint state so that every word is allowed.
+ * @param constraint The constraint state to initialize.
+ */
+void constraint_init(Constraint *constraint)
+{
+    memset(constraint, 0, sizeof(*constraint));
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        constraint->allowed[i] = ALL_LETTERS;
+    }
+    memset(constraint->max_count, WORD_LEN, sizeof(constraint->max_count));
+}
+
+/**
+ * Folds the server's marks for one guess into the constraint state.
+ * @param constraint The constraint state to update.
+ * @param guess The guessed word.
+ * @param marks The marks for each position (2 = correct position, 1 = wrong position, 0 = not in word).
+ */
+void constraint_apply(Constraint *constraint, const char *guess, const int *marks)
+{
+    int present[ALPHABET_SIZE] = {0}; // Non-gray marks per letter in this guess
+    uint32_t guessed = 0;             // Letters in this guess
+    uint32_t capped = 0;              // Letters with at least one gray mark in this guess
+
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        int code = guess[i] - 'a';
+        guessed |= LETTER_BIT(code);
+        if (marks[i] == 2)
+        {
+            // The letter at this position is known
+            constraint->allowed[i] = LETTER_BIT(code);
+            present[code]++;
+        }
+        else
+        {
+            // Yellow and gray both rule the letter out at this position
+            constraint->allowed[i] &= ~LETTER_BIT(code);
+            if (marks[i] == 1)
+            {
+                present[code]++;
+            }
+            else
+            {
+                capped |= LETTER_BIT(code);
+            }
+        }
+    }
+
+    // Update the occurrence bounds of every guessed letter
+    uint32_t letters = guessed;
+    while (letters != 0)
+    {
+        int code = __builtin_ctz(letters);
+        letters &= letters - 1;
+
+        if (present[code] > constraint->min_count[code])
+        {
+            constraint->min_count[code] = (uint8_t)present[code];
+        }
+        if ((capped & LETTER_BIT(code)) && present[code] < constraint->max_count[code])
+        {
+            constraint->max_count[code] = (uint8_t)present[code];
+        }
+
+        if (constraint->min_count[code] > 0)
+        {
+            constraint->required |= LETTER_BIT(code);
+        }
+        if (constraint->max_count[code] == 0)
+        {
+            // Not in the word at all
+            for (int i = 0; i < WORD_LEN; i++)
+            {
+                constraint->allowed[i] &= ~LETTER_BIT(code);
+            }
+        }
+        else if (constraint->min_count[code] > 1 || constraint->max_count[code] < WORD_LEN)
+        {
+            // Presence alone does not capture the bound
+            constraint->counted |= LETTER_BIT(code);
+        }
+    }
+}
+
+/**
+ * Hashes a constraint state. The state does not depend on the order the guesses
+ * were made in, so games that learned the same facts get the same hash.
+ * @param constraint The constraint state.
+ * @param seed Mixed into the hash, to keep the keys of different strategies apart.
+ * @return A 64-bit FNV-1a hash of the state.
+ */
+uint64_t constraint_hash(const Constraint *constraint, uint64_t seed)
+{
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        hash = (hash ^ constraint->allowed[i]) * 1099511628211ull;
+    }
+    hash = (hash ^ constraint->required) * 1099511628211ull;
+
+    // "counted" follows from the bounds, so only the bounds are hashed
+    for (int c = 0; c < ALPHABET_SIZE; c++)
+    {
+        hash = (hash ^ ((uint64_t)constraint->min_count[c] << 8 | constraint->max_count[c])) * 1099511628211ull;
+    }
+    return hash;
+}
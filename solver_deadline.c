@@ -0,0 +1,69 @@
+/**
+ * Decision Deadlines for the 3700.network Project - Client Word Solver
+ *
+ * A deadline bounds the time one decision may take. The searches check it
+ * every few guesses, keep the best guess found so far, and stop once it has
+ * passed; the deadline then records that it was hit, so the caller knows the
+ * decision was cut short. Another thread can also abandon a decision through
+ * the deadline's cancel flag, as the speculation does (solver_speculate.c).
+ */
+
+#include "solver.h"
+
+/**
+ * Starts a deadline.
+ * @param deadline The deadline to start.
+ * @param budget_us Time allowed from now in microseconds, 0 for no deadline.
+ */
+void deadline_start(Deadline *deadline, int budget_us)
+{
+    deadline->at_ns = budget_us > 0 ? timing_now_ns() + (uint64_t)budget_us * 1000ull : 0;
+    deadline->expired = 0;
+    deadline->cancel = NULL;
+}
+
+/**
+ * Records that a decision was cut short, so it is not shared like a full one.
+ * @param deadline The deadline, or NULL for none.
+ */
+void deadline_expire(Deadline *deadline)
+{
+    if (deadline != NULL)
+    {
+        __atomic_store_n(&deadline->expired, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * Checks whether a deadline has passed, and records it if so.
+ * @param deadline The deadline, or NULL for none.
+ * @return 1 if the search must stop, 0 otherwise.
+ *
+ * Note: Safe to call from several threads working on the same decision.
+ */
+int deadline_passed(Deadline *deadline)
+{
+    if (deadline == NULL)
+    {
+        return 0;
+    }
+    if (__atomic_load_n(&deadline->expired, __ATOMIC_RELAXED))
+    {
+        return 1;
+    }
+    if (deadline->cancel != NULL && __atomic_load_n(deadline->cancel, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&deadline->expired, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    if (deadline->at_ns == 0)
+    {
+        return 0;
+    }
+    if (timing_now_ns() >= deadline->at_ns)
+    {
+        __atomic_store_n(&deadline->expired, 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    return 0;
+}
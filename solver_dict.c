@@ -0,0 +1,234 @@
+/**
+ * Dictionary Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file loads the word list into memory and encodes every word into the
+ * representation described in solver.h (letter codes, letter-presence mask and
+ * packed positional codes), then builds the positional bitset index. Encoding happens exactly once per word when the
+ * dictionary is loaded, so the game loop never touches the raw text again.
+ * The compiled dictionary file (solver_dictfile.c) stores the result, so the
+ * client can map it instead of parsing the word list.
+ */
+
+#include "solver.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/**
+ * Computes the FNV-1a hash of a list of words, in order.
+ * @param words The words.
+ * @param num_words The number of words.
+ * @return The hash, as dict_checksum() returns it for a dictionary of these words.
+ */
+uint32_t dict_words_checksum(const DictWord *words, int num_words)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < num_words; i++)
+    {
+        for (int j = 0; j < WORD_LEN; j++)
+        {
+            hash ^= (uint8_t)words[i].text[j];
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+/**
+ * Encodes a single word into a DictWord.
+ * @param word The DictWord to fill in.
+ * @param text The word, optionally followed by a newline.
+ * @return 0 on success, -1 if the word is not WORD_LEN lowercase letters.
+ */
+int word_encode(DictWord *word, const char *text)
+{
+    memset(word, 0, sizeof(*word));
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        if (text[i] < 'a' || text[i] > 'z')
+        {
+            return -1;
+        }
+        uint8_t code = (uint8_t)(text[i] - 'a');
+        word->text[i] = text[i];
+        word->codes[i] = code;
+        word->mask |= LETTER_BIT(code);
+        word->packed |= (PackedWord)code << (i * CODE_BITS);
+    }
+    // Allow a trailing newline (or carriage return) but nothing else
+    if (text[WORD_LEN] != '\0' && text[WORD_LEN] != '\n' && text[WORD_LEN] != '\r')
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Loads and encodes every word of a word list file.
+ * @param dict The dictionary to fill in.
+ * @param path Path of the word list, one word per line.
+ * @return 0 on success, -1 if the file cannot be read or the words and index
+ *         cannot be allocated (errno is set).
+ *
+ * Note: Lines that are not valid words are skipped and counted in
+ * num_rejected (blank lines are ignored). The caller must release the
+ * dictionary with dict_free().
+ */
+int dict_load(Dictionary *dict, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    memset(dict, 0, sizeof(*dict));
+    int capacity = 16384;
+    dict->words = (DictWord *)malloc(capacity * sizeof(DictWord));
+    if (dict->words == NULL)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    char line[64];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (dict->num_words == capacity)
+        {
+            DictWord *grown = (DictWord *)realloc(dict->words, 2 * capacity * sizeof(DictWord));
+            if (grown == NULL)
+            {
+                fclose(file);
+                dict_free(dict);
+                return -1;
+            }
+            dict->words = grown;
+            capacity *= 2;
+        }
+        if (word_encode(&dict->words[dict->num_words], line) == 0)
+        {
+            dict->num_words++;
+        }
+        else if (line[strspn(line, "\r\n")] != '\0')
+        {
+            dict->num_rejected++;
+        }
+    }
+    fclose(file);
+
+    if (letter_index_build(&dict->index, dict) == -1)
+    {
+        dict_free(dict);
+        errno = ENOMEM;
+        return -1;
+    }
+    dict->checksum = dict_words_checksum(dict->words, dict->num_words);
+    return 0;
+}
+
+/**
+ * Reads the word length of a word list without loading it.
+ * @param path Path of the word list, one word per line.
+ * @return The length of the first word, or -1 if the file cannot be read or
+ *         does not start with a word.
+ *
+ * Note: The solver is built for WORD_LEN letters, so a client uses this to pick
+ * the build that matches the word list.
+ */
+int dict_word_len(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    char line[64];
+    int len = -1;
+    if (fgets(line, sizeof(line), file) != NULL)
+    {
+        len = 0;
+        while (line[len] >= 'a' && line[len] <= 'z')
+        {
+            len++;
+        }
+        if (len == 0)
+        {
+            len = -1;
+        }
+    }
+    fclose(file);
+    return len;
+}
+
+/**
+ * Checks that a word list was made for this build, for the tools that compile it.
+ * @param dict The dictionary loaded from the word list.
+ * @param path Path of the word list, for the message.
+ * @return 0 if every line is a WORD_LEN-letter word and there is at least one,
+ *         -1 otherwise, after printing why to stderr.
+ */
+int dict_check(const Dictionary *dict, const char *path)
+{
+    if (dict->num_rejected > 0 || dict->num_words == 0)
+    {
+        int word_len = dict_word_len(path);
+        fprintf(stderr, "%s: %d of %d lines are not %d-letter words", path, dict->num_rejected,
+                dict->num_words + dict->num_rejected, WORD_LEN);
+        if (word_len != -1 && word_len != WORD_LEN)
+        {
+            fprintf(stderr, " (use the %d-letter build, make variants)", word_len);
+        }
+        fprintf(stderr, "\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Finds a word in the dictionary, through the letter index rather than by
+ * comparing it with every word.
+ * @param dict The loaded dictionary.
+ * @param text The word to look for.
+ * @return Dictionary index of the word, or -1 if it is not in the dictionary.
+ */
+int dict_find(const Dictionary *dict, const char *text)
+{
+    DictWord word;
+    if (word_encode(&word, text) == -1 || text[WORD_LEN] != '\0')
+    {
+        return -1;
+    }
+    return letter_index_find(&dict->index, &word);
+}
+
+/**
+ * Returns the checksum of the dictionary words, used to tie precomputed files to a word list.
+ * @param dict The loaded dictionary.
+ * @return The 32-bit FNV-1a hash of all words in order, computed when the dictionary was loaded.
+ */
+uint32_t dict_checksum(const Dictionary *dict)
+{
+    return dict->checksum;
+}
+
+/**
+ * Releases the memory held by a dictionary, or unmaps its compiled dictionary file.
+ * @param dict The dictionary to free.
+ */
+void dict_free(Dictionary *dict)
+{
+    if (dict->map != NULL)
+    {
+        // The words and index live in the mapping
+        munmap(dict->map, dict->map_size);
+    }
+    else
+    {
+        letter_index_free(&dict->index);
+        free(dict->words);
+    }
+    memset(dict, 0, sizeof(*dict));
+}
@@ -0,0 +1,220 @@
+/**
+ * Compiled Dictionary Functions for the 3700.network Project - Client Word Solver
+ *
+ * Loading word_list.txt reads, validates and encodes every line and builds the
+ * letter index, which takes milliseconds and gives every client process its
+ * own copy. This file writes the loaded dictionary to a versioned file (see
+ * DictFileHeader in solver.h): the encoded words (text, letter codes, letter
+ * mask and packed codes) followed by the letter index bitsets. The client maps
+ * the file read-only and points the dictionary into the mapping, so loading is
+ * a header check, and every client process shares one page-cache copy.
+ *
+ * The header records the size and modification time of the word list the
+ * file was compiled from, and a file whose word list has changed since is
+ * ignored, so the client falls back to parsing the word list. So is a file
+ * whose size or index does not match its header, or whose words do not match
+ * their checksum or encodings, since a damaged word would index the solver's
+ * tables out of bounds.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Returns the modification time of a file in nanoseconds.
+ */
+static int64_t mtime_ns(const struct stat *info)
+{
+    return (int64_t)info->st_mtim.tv_sec * 1000000000 + info->st_mtim.tv_nsec;
+}
+
+/**
+ * Returns 1 if the word list a compiled dictionary was compiled from has changed
+ * since. A missing word list, or no path, counts as unchanged.
+ */
+static int source_changed(const DictFileHeader *header, const char *source_path)
+{
+    struct stat source;
+    return source_path != NULL && stat(source_path, &source) == 0 &&
+           ((uint64_t)source.st_size != header->source_size || mtime_ns(&source) != header->source_mtime);
+}
+
+/**
+ * Number of bitsets in a letter index (see solver_bitset.c).
+ */
+static size_t index_bitsets(void)
+{
+    return WORD_LEN * ALPHABET_SIZE + ALPHABET_SIZE * WORD_LEN;
+}
+
+/**
+ * Returns 1 if mapped words are the encodings of their text and match the checksum in the header.
+ */
+static int words_valid(const DictWord *words, const DictFileHeader *header)
+{
+    for (uint32_t w = 0; w < header->num_words; w++)
+    {
+        DictWord encoded;
+        if (word_encode(&encoded, words[w].text) == -1 || memcmp(&encoded, &words[w], sizeof(encoded)) != 0)
+        {
+            return 0;
+        }
+    }
+    return dict_words_checksum(words, (int)header->num_words) == header->dict_checksum;
+}
+
+/**
+ * Writes a loaded dictionary to a compiled dictionary file.
+ * @param dict The loaded dictionary.
+ * @param path Path of the file to write.
+ * @param source_path Path of the word list the dictionary was loaded from.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int dict_write(const Dictionary *dict, const char *path, const char *source_path)
+{
+    struct stat source;
+    if (stat(source_path, &source) == -1)
+    {
+        return -1;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    DictFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DICT_FILE_MAGIC, sizeof(header.magic));
+    header.version = DICT_FILE_VERSION;
+    header.word_len = WORD_LEN;
+    header.word_size = sizeof(DictWord);
+    header.num_words = (uint32_t)dict->num_words;
+    header.dict_checksum = dict_checksum(dict);
+    header.num_blocks = (uint32_t)dict->index.num_blocks;
+    // The index is read with aligned vector loads, so it starts on a cache line
+    size_t words_end = sizeof(header) + (size_t)dict->num_words * sizeof(DictWord);
+    header.index_offset = (uint32_t)((words_end + 63) / 64 * 64);
+    header.source_size = (uint64_t)source.st_size;
+    header.source_mtime = mtime_ns(&source);
+
+    static const char padding[64] = {0};
+    size_t num_bits = index_bitsets() * dict->index.num_blocks;
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                         fwrite(dict->words, sizeof(DictWord), dict->num_words, file) == (size_t)dict->num_words &&
+                         fwrite(padding, 1, header.index_offset - words_end, file) == header.index_offset - words_end &&
+                         fwrite(dict->index.bits, sizeof(uint64_t), num_bits, file) == num_bits
+                     ? 0
+                     : -1;
+    if (fclose(file) != 0)
+    {
+        result = -1;
+    }
+    return result;
+}
+
+/**
+ * Maps a compiled dictionary file read-only and uses it in place.
+ * @param dict The dictionary to fill in. It is left empty if the file cannot be used.
+ * @param path Path of the compiled dictionary file.
+ * @param source_path Path of the word list the file must have been compiled from,
+ *                    or NULL to skip the check. A missing word list is not checked.
+ * @return 0 on success, -1 if the file is missing, was written by another build,
+ *         is truncated or damaged, or its word list has changed since.
+ *
+ * Note: The words and index must not be modified. The caller must release the
+ * dictionary with dict_free(), which unmaps the file.
+ */
+int dict_open(Dictionary *dict, const char *path, const char *source_path)
+{
+    memset(dict, 0, sizeof(*dict));
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    struct stat info;
+    DictFileHeader header;
+    if (fstat(fd, &info) == -1 || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+    {
+        close(fd);
+        return -1;
+    }
+    size_t expected = header.index_offset + index_bitsets() * header.num_blocks * sizeof(uint64_t);
+    if (memcmp(header.magic, DICT_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != DICT_FILE_VERSION ||
+        header.word_len != WORD_LEN || header.word_size != sizeof(DictWord) || header.num_words == 0 ||
+        header.index_offset % 64 != 0 ||
+        header.index_offset < sizeof(header) + (size_t)header.num_words * sizeof(DictWord) ||
+        header.num_words > INT32_MAX - 255 || header.num_blocks != (uint32_t)letter_index_blocks((int)header.num_words) ||
+        (size_t)info.st_size != expected)
+    {
+        fprintf(stderr, "Ignoring %s: built for another version or word length, or truncated\n", path);
+        close(fd);
+        return -1;
+    }
+
+    if (source_changed(&header, source_path))
+    {
+        fprintf(stderr, "Ignoring %s: %s has changed since\n", path, source_path);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, expected, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED)
+    {
+        return -1;
+    }
+    if (!words_valid((const DictWord *)((char *)map + sizeof(header)), &header))
+    {
+        fprintf(stderr, "Ignoring %s: its words are damaged\n", path);
+        munmap(map, expected);
+        return -1;
+    }
+
+    // Read-only from here on: the pages are shared with every other client
+    dict->words = (DictWord *)((char *)map + sizeof(header));
+    dict->num_words = (int)header.num_words;
+    dict->index.bits = (uint64_t *)((char *)map + header.index_offset);
+    dict->index.num_blocks = (int)header.num_blocks;
+    dict->checksum = header.dict_checksum;
+    dict->map = map;
+    dict->map_size = expected;
+    return 0;
+}
+
+/**
+ * Reads the word length of a compiled dictionary without mapping it.
+ * @param path Path of the compiled dictionary file.
+ * @param source_path Path of the word list it must have been compiled from, or NULL to skip the check.
+ * @return The word length in the header, or -1 if the file cannot be read, is
+ *         not a compiled dictionary, holds no words or its word list has changed.
+ *
+ * Note: Unlike dict_open(), any word length is accepted, so a client can pick
+ * the build that matches the file.
+ */
+int dict_file_word_len(const char *path, const char *source_path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    DictFileHeader header;
+    ssize_t size = pread(fd, &header, sizeof(header), 0);
+    close(fd);
+    if (size != (ssize_t)sizeof(header) || memcmp(header.magic, DICT_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != DICT_FILE_VERSION || header.num_words == 0 || source_changed(&header, source_path))
+    {
+        return -1;
+    }
+    return (int)header.word_len;
+}
@@ -0,0 +1,409 @@
+/**
+ * Endgame Search for the 3700.network Project - Client Word Solver
+ *
+ * Once few candidates survive, the best guess no longer has to be estimated:
+ * the whole game tree is small enough to search. This file finds the guess that
+ * first minimizes the number of guesses needed in the worst case, then the
+ * expected number of guesses, by a full search over
+ *
+ *     depth(S) = 1 + max over patterns p != solved of depth(S_p)
+ *     total(S) = |S| + sum over patterns p != solved of total(S_p)
+ *
+ * where S_p are the survivors that answer the guess with pattern p, and
+ * total(S) is the number of guesses summed over every possible answer in S.
+ * The guesses considered at every node are the survivors themselves plus a few
+ * probe words, the best non-survivors by expected information at the root. The
+ * result is the best over those guesses, not over the whole dictionary: a word
+ * that splits some subtree well but the root poorly is never tried.
+ *
+ * Results are memoized per survivor set, and a guess is skipped as soon as a
+ * lower bound on its cost (one guess for every answer, plus a second one for
+ * all but one answer of each bucket) cannot beat the best guess found so far.
+ * The search gives up when it runs past its time budget or its memo cannot
+ * grow, and the caller falls back to its heuristic. Without a time budget the
+ * outcome depends on nothing but the survivors, so simulations are reproducible.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ENDGAME_CHECK_INTERVAL 64 // Searched nodes between two looks at the clock
+
+/**
+ * A solved survivor set.
+ */
+typedef struct
+{
+    uint64_t hash; // 0 for an empty slot
+    int *subset;   // The survivors, in dictionary order
+    int count;
+    int depth; // Guesses needed for the worst answer in the subset
+    int total; // Guesses summed over every answer in the subset
+    int guess; // The guess that achieves them
+} EndgameEntry;
+
+/**
+ * The state of one search.
+ */
+typedef struct
+{
+    const Solver *solver;
+    const int *probes; // Non-survivor guesses tried at every node
+    int num_probes;
+    EndgameEntry *memo; // Open addressing, capacity is a power of two
+    int capacity;
+    int used;
+    Deadline budget;    // The search's own time budget
+    Deadline *deadline; // The deadline of the whole decision, NULL if none
+    int nodes;          // Searched nodes, to pace the clock checks
+    int expired;        // Set once either deadline has passed or the memo cannot grow
+} Endgame;
+
+/**
+ * Hashes a survivor set (FNV-1a over the indexes), never returning 0.
+ */
+static uint64_t subset_hash(const int *subset, int count)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < count; i++)
+    {
+        hash ^= (uint64_t)subset[i];
+        hash *= 1099511628211ull;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+static EndgameEntry *memo_find(Endgame *eg, uint64_t hash, const int *subset, int count)
+{
+    for (int slot = (int)(hash & (eg->capacity - 1));; slot = (slot + 1) & (eg->capacity - 1))
+    {
+        EndgameEntry *entry = &eg->memo[slot];
+        if (entry->hash == 0)
+        {
+            return NULL;
+        }
+        if (entry->hash == hash && entry->count == count && memcmp(entry->subset, subset, count * sizeof(int)) == 0)
+        {
+            return entry;
+        }
+    }
+}
+
+/**
+ * Memoizes a solved survivor set. If memory runs out, the set is not memoized
+ * and the search gives up.
+ */
+static void memo_insert(Endgame *eg, uint64_t hash, const int *subset, int count, int depth, int total, int guess)
+{
+    // Keep the table at most half full
+    if (2 * (eg->used + 1) > eg->capacity)
+    {
+        EndgameEntry *grown = (EndgameEntry *)calloc(2 * (size_t)eg->capacity, sizeof(EndgameEntry));
+        if (grown == NULL)
+        {
+            eg->expired = 1;
+            return;
+        }
+        EndgameEntry *old = eg->memo;
+        int old_capacity = eg->capacity;
+        eg->capacity *= 2;
+        eg->memo = grown;
+        for (int i = 0; i < old_capacity; i++)
+        {
+            if (old[i].hash != 0)
+            {
+                int slot = (int)(old[i].hash & (eg->capacity - 1));
+                while (eg->memo[slot].hash != 0)
+                {
+                    slot = (slot + 1) & (eg->capacity - 1);
+                }
+                eg->memo[slot] = old[i];
+            }
+        }
+        free(old);
+    }
+
+    int *copy = (int *)malloc(count * sizeof(int));
+    if (copy == NULL)
+    {
+        eg->expired = 1;
+        return;
+    }
+    int slot = (int)(hash & (eg->capacity - 1));
+    while (eg->memo[slot].hash != 0)
+    {
+        slot = (slot + 1) & (eg->capacity - 1);
+    }
+    EndgameEntry *entry = &eg->memo[slot];
+    entry->hash = hash;
+    entry->subset = copy;
+    memcpy(entry->subset, subset, count * sizeof(int));
+    entry->count = count;
+    entry->depth = depth;
+    entry->total = total;
+    entry->guess = guess;
+    eg->used++;
+}
+
+/**
+ * Returns 1 once the search has run past its deadline.
+ */
+static int endgame_expired(Endgame *eg)
+{
+    if (!eg->expired && ++eg->nodes % ENDGAME_CHECK_INTERVAL == 0)
+    {
+        eg->expired = deadline_passed(&eg->budget) || deadline_passed(eg->deadline);
+    }
+    return eg->expired;
+}
+
+/**
+ * Orders guesses: fewer guesses in the worst case, then fewer in total, then a
+ * guess that can be the answer, then the earliest word.
+ * @return 1 if guess a with cost a_cost is preferred over guess b with cost b_cost.
+ */
+static int endgame_better(EndgameCost a_cost, int a, int a_is_candidate, EndgameCost b_cost, int b, int b_is_candidate)
+{
+    if (b < 0)
+    {
+        return 1;
+    }
+    if (a_cost.depth != b_cost.depth)
+    {
+        return a_cost.depth < b_cost.depth;
+    }
+    if (a_cost.total != b_cost.total)
+    {
+        return a_cost.total < b_cost.total;
+    }
+    if (a_is_candidate != b_is_candidate)
+    {
+        return a_is_candidate;
+    }
+    return a < b;
+}
+
+/**
+ * Finds the guess with the lowest cost over a survivor set.
+ * @param subset The survivors, in dictionary order.
+ * @param count The number of survivors, at most ENDGAME_MAX_CANDIDATES.
+ * @param best_guess Receives the best guess.
+ * @param cost Receives the cost of the best guess.
+ * @return 0 on success, -1 if the budget ran out.
+ */
+static int endgame_solve(Endgame *eg, const int *subset, int count, int *best_guess, EndgameCost *cost)
+{
+    // One survivor is guessed right away, and of two, guessing either one leaves one more guess at most
+    if (count <= 2)
+    {
+        *best_guess = subset[0];
+        cost->depth = count;
+        cost->total = 2 * count - 1;
+        return 0;
+    }
+
+    uint64_t hash = subset_hash(subset, count);
+    EndgameEntry *entry = memo_find(eg, hash, subset, count);
+    if (entry != NULL)
+    {
+        *best_guess = entry->guess;
+        cost->depth = entry->depth;
+        cost->total = entry->total;
+        return 0;
+    }
+    if (endgame_expired(eg))
+    {
+        return -1;
+    }
+
+    EndgameCost best_cost = {0, 0};
+    int best = -1;
+    int best_is_candidate = 0;
+    for (int k = 0; k < count + eg->num_probes; k++)
+    {
+        int is_candidate = k < count;
+        int guess = is_candidate ? subset[k] : eg->probes[k - count];
+
+        // Bucket the survivors by the pattern they answer this guess with
+        Pattern patterns[ENDGAME_MAX_CANDIDATES];
+        int sizes[NUM_PATTERNS];
+        memset(sizes, 0, sizeof(sizes));
+        for (int i = 0; i < count; i++)
+        {
+            patterns[i] = (Pattern)solver_pattern(eg->solver, guess, subset[i]);
+            sizes[patterns[i]]++;
+        }
+
+        // A guess that does not split the survivors gets nowhere
+        if (sizes[patterns[0]] == count && patterns[0] != PATTERN_SOLVED)
+        {
+            continue;
+        }
+
+        // Every bucket needs one more guess, and all but one of its answers a second one
+        EndgameCost bound = {1, count};
+        for (int p = 0; p < PATTERN_SOLVED; p++)
+        {
+            if (sizes[p] > 0)
+            {
+                bound.total += 2 * sizes[p] - 1;
+                if (1 + (sizes[p] > 1 ? 2 : 1) > bound.depth)
+                {
+                    bound.depth = 1 + (sizes[p] > 1 ? 2 : 1);
+                }
+            }
+        }
+        if (!endgame_better(bound, guess, is_candidate, best_cost, best, best_is_candidate))
+        {
+            continue;
+        }
+
+        // Solve every bucket exactly, stopping once the guess cannot win
+        EndgameCost guess_cost = {bound.depth, count};
+        int remaining = bound.total - count;
+        int pruned = 0;
+        for (int p = 0; p < PATTERN_SOLVED && !pruned; p++)
+        {
+            if (sizes[p] == 0)
+            {
+                continue;
+            }
+            int bucket[ENDGAME_MAX_CANDIDATES];
+            int size = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (patterns[i] == p)
+                {
+                    bucket[size++] = subset[i];
+                }
+            }
+
+            int next_guess;
+            EndgameCost sub_cost;
+            if (endgame_solve(eg, bucket, size, &next_guess, &sub_cost) == -1)
+            {
+                return -1;
+            }
+            guess_cost.total += sub_cost.total;
+            if (1 + sub_cost.depth > guess_cost.depth)
+            {
+                guess_cost.depth = 1 + sub_cost.depth;
+            }
+            remaining -= 2 * size - 1;
+
+            EndgameCost partial = {guess_cost.depth, guess_cost.total + remaining};
+            pruned = !endgame_better(partial, guess, is_candidate, best_cost, best, best_is_candidate);
+        }
+        if (!pruned)
+        {
+            best_cost = guess_cost;
+            best = guess;
+            best_is_candidate = is_candidate;
+        }
+    }
+
+    memo_insert(eg, hash, subset, count, best_cost.depth, best_cost.total, best);
+    *best_guess = best;
+    *cost = best_cost;
+    return 0;
+}
+
+/**
+ * Finds a survivor whose feedback tells every other survivor apart. Guessing it
+ * takes two guesses at most and 2 * count - 1 in total, which no other guess
+ * can beat, since a guess that cannot be the answer takes two for every answer.
+ * @return Dictionary index of the earliest such survivor, or -1 if there is none.
+ */
+static int endgame_perfect_guess(const Solver *solver, const CandidateSet *candidates)
+{
+    for (int k = 0; k < candidates->count; k++)
+    {
+        uint8_t seen[NUM_PATTERNS] = {0};
+        int perfect = 1;
+        for (int i = 0; i < candidates->count && perfect; i++)
+        {
+            int pattern = solver_pattern(solver, candidates->index[k], candidates->index[i]);
+            perfect = !seen[pattern];
+            seen[pattern] = 1;
+        }
+        if (perfect)
+        {
+            return candidates->index[k];
+        }
+    }
+    return -1;
+}
+
+/**
+ * Finds the guess that minimizes the expected number of guesses, by searching
+ * the full game tree over the survivors and the probe words picked at the root.
+ * The guess is the best over those words, not over the whole dictionary.
+ * @param solver The solver holding the dictionary and pattern matrix.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @param budget_ms Time budget of the search in milliseconds, 0 for no limit.
+ * @param deadline The deadline of the whole decision, or NULL if none. The search stops at the earlier of the two.
+ * @param cost If not NULL, receives the worst-case and total number of guesses of the best guess.
+ * @return Dictionary index of the best guess, or -1 if there are too many
+ *         candidates, the search ran out of time or memory.
+ *
+ * Note: A caller that falls back to another guess on -1 must not share that
+ * guess as a full decision; it depends on how fast the search ran.
+ */
+int endgame_best_guess(const Solver *solver, const CandidateSet *candidates, int budget_ms, Deadline *deadline, EndgameCost *cost)
+{
+    if (candidates->count == 0 || candidates->count > ENDGAME_MAX_CANDIDATES)
+    {
+        return -1;
+    }
+
+    // Picking the probe words costs more than the search, so first look for a guess nothing beats
+    int perfect = endgame_perfect_guess(solver, candidates);
+    if (perfect != -1)
+    {
+        if (cost != NULL)
+        {
+            cost->depth = candidates->count > 1 ? 2 : 1;
+            cost->total = 2 * candidates->count - 1;
+        }
+        return perfect;
+    }
+
+    Endgame eg;
+    memset(&eg, 0, sizeof(eg));
+    eg.solver = solver;
+    deadline_start(&eg.budget, budget_ms * 1000);
+    eg.deadline = deadline;
+
+    int probes[ENDGAME_PROBES];
+    eg.probes = probes;
+    eg.num_probes = candidates->count > 2 ? entropy_best_probes(solver, candidates, ENDGAME_PROBES, probes, deadline) : 0;
+    if (eg.num_probes == -1)
+    {
+        return -1;
+    }
+    eg.capacity = 1024;
+    eg.memo = (EndgameEntry *)calloc(eg.capacity, sizeof(EndgameEntry));
+    if (eg.memo == NULL)
+    {
+        return -1;
+    }
+
+    int guess = -1;
+    EndgameCost best_cost;
+    if (endgame_solve(&eg, candidates->index, candidates->count, &guess, &best_cost) == -1)
+    {
+        guess = -1;
+    }
+    else if (cost != NULL)
+    {
+        *cost = best_cost;
+    }
+
+    for (int i = 0; i < eg.capacity; i++)
+    {
+        free(eg.memo[i].subset);
+    }
+    free(eg.memo);
+    return guess;
+}
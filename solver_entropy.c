@@ -0,0 +1,976 @@
+/**
+ * Entropy Strategy for the 3700.network Project - Client Word Solver
+ *
+ * This file scores possible guesses by the expected information of the
+ * feedback they produce. For a guess g, the surviving candidates are split
+ * into buckets by the pattern feedback_pattern(g, answer) they would return;
+ * with n_b answers in bucket b out of N survivors, the expected information is
+ *
+ *     H(g) = log2(N) - (1 / N) * sum_b n_b * log2(n_b)
+ *
+ * Within one decision N is fixed, so guesses are ranked by the cost
+ * sum_b n_b * log2(n_b) alone, lower being better. Without a prior, n_b is a
+ * count, and the cost is summed in integers from a fixed-point table of
+ * n * log2(n) (ENTROPY_FIXED_BITS fractional bits), so the scoring loop calls
+ * no log2() at all. Two costs are tied when their scores would be closer than
+ * ENTROPY_EPSILON, which picks the same guesses as scoring in floating point.
+ *
+ * When the solver has an answer prior (solver_prior.c), n_b and N are the
+ * summed prior weights of the answers instead of their counts, so the score is
+ * the expected information over the likely answers, computed in floating point.
+ *
+ * Every dictionary word is considered as a guess, not only the survivors,
+ * because a word that is known to be wrong can still split the survivors
+ * better than any of them. Patterns come from the pattern matrix when it is
+ * loaded, which turns each one into a single byte load. Otherwise the
+ * survivors are packed once per decision and every guess is run through the
+ * SIMD feedback kernel (solver_kernel.c).
+ *
+ * Many games waiting for a decision at once can be decided in one batch
+ * (entropy_best_guesses()). Each decision still ranks and prunes its own
+ * guesses, but the guesses of every decision are scored together in
+ * dictionary order, so a row of the pattern matrix is loaded once for all the
+ * decisions that score it, and the matrix is read front to back. The guesses
+ * are split between the workers of the pool in runs of whole rows.
+ */
+
+#include "solver.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Turns a feedback histogram over count answers into expected information.
+ */
+static double histogram_entropy(const int *histogram, int count)
+{
+    double sum = 0.0;
+    for (int p = 0; p < NUM_PATTERNS; p++)
+    {
+        if (histogram[p] > 1)
+        {
+            sum += histogram[p] * log2((double)histogram[p]);
+        }
+    }
+    return log2((double)count) - sum / count;
+}
+
+/**
+ * Builds the table of n * log2(n) in fixed point, for n = 0..max.
+ * @param max The largest bucket size, the number of dictionary words.
+ * @return The table, or NULL if it cannot be allocated.
+ *
+ * Note: Entries stay below 2^53, so each one is exactly the rounded value. The
+ * caller must release the table with free().
+ */
+uint64_t *entropy_table_create(int max)
+{
+    uint64_t *table = (uint64_t *)malloc(((size_t)max + 1) * sizeof(uint64_t));
+    if (table == NULL)
+    {
+        return NULL;
+    }
+    for (int n = 0; n <= max; n++)
+    {
+        table[n] = n > 1 ? (uint64_t)llround(n * log2((double)n) * (double)(1ull << ENTROPY_FIXED_BITS)) : 0;
+    }
+    return table;
+}
+
+/**
+ * Turns a feedback histogram into its fixed-point cost, the sum of n * log2(n) over the buckets.
+ */
+static uint64_t histogram_cost(const uint64_t *nlog2n, const int *histogram)
+{
+    uint64_t cost = 0;
+    for (int p = 0; p < NUM_PATTERNS; p++)
+    {
+        cost += nlog2n[histogram[p]];
+    }
+    return cost;
+}
+
+/**
+ * Turns a fixed-point cost over count answers into expected information.
+ */
+static double cost_entropy(uint64_t cost, int count)
+{
+    return log2((double)count) - (double)cost / ((double)count * (double)(1ull << ENTROPY_FIXED_BITS));
+}
+
+/**
+ * Turns a feedback histogram of prior weights summing to total into expected information.
+ */
+static double mass_entropy(const double *mass, double total)
+{
+    double sum = 0.0;
+    for (int p = 0; p < NUM_PATTERNS; p++)
+    {
+        if (mass[p] > 0.0)
+        {
+            sum += mass[p] * log2(mass[p]);
+        }
+    }
+    return log2(total) - sum / total;
+}
+
+/**
+ * How the guesses of one decision are scored and compared.
+ */
+typedef struct
+{
+    const uint64_t *nlog2n; // Fixed-point n * log2(n), NULL to score in floating point
+    uint64_t tolerance;     // Cost difference below which two guesses are tied
+    double total_weight;    // The summed prior weights of the survivors (their count without a prior)
+} Scoring;
+
+/**
+ * Scores a guess with the prior weights of the survivors.
+ */
+static double score_weighted(const Solver *solver, int guess, const CandidateSet *candidates,
+                             const AnswerBlock *answers, Pattern *patterns, WorkerScratch *scratch, double total_weight)
+{
+    const double *weights = solver->prior.weights;
+    double *mass = scratch->mass;
+    memset(mass, 0, NUM_PATTERNS * sizeof(double));
+
+    const Pattern *row = solver_pattern_row(solver, guess);
+    if (row == NULL && answers != NULL)
+    {
+        feedback_block(&solver->dict.words[guess], answers, patterns);
+    }
+    for (int i = 0; i < candidates->count; i++)
+    {
+        int answer = candidates->index[i];
+        int pattern;
+        if (row != NULL)
+        {
+            pattern = row[answer];
+        }
+        else if (answers != NULL)
+        {
+            pattern = patterns[i];
+        }
+        else
+        {
+            pattern = feedback_pattern(&solver->dict.words[guess], &solver->dict.words[answer]);
+        }
+        mass[pattern] += weights[answer];
+    }
+    return mass_entropy(mass, total_weight);
+}
+
+/**
+ * Fills in the feedback histogram of a guess over the survivors.
+ * @param answers The survivors packed for the feedback kernel, or NULL to use the pattern matrix.
+ * @param patterns Kernel output buffer of answers->padded entries (unused with the pattern matrix).
+ */
+static void fill_histogram(const Solver *solver, int guess, const CandidateSet *candidates,
+                           const AnswerBlock *answers, Pattern *patterns, WorkerScratch *scratch)
+{
+
+    int *histogram = scratch->histogram;
+    memset(histogram, 0, NUM_PATTERNS * sizeof(int));
+
+    const Pattern *row = solver_pattern_row(solver, guess);
+    if (row != NULL)
+    {
+        for (int i = 0; i < candidates->count; i++)
+        {
+            histogram[row[candidates->index[i]]]++;
+        }
+    }
+    else if (answers != NULL)
+    {
+        feedback_block(&solver->dict.words[guess], answers, patterns);
+        for (int i = 0; i < answers->count; i++)
+        {
+            histogram[patterns[i]]++;
+        }
+    }
+    else
+    {
+        const DictWord *words = solver->dict.words;
+        for (int i = 0; i < candidates->count; i++)
+        {
+            histogram[feedback_pattern(&words[guess], &words[candidates->index[i]])]++;
+        }
+    }
+}
+
+/**
+ * Scores a guess using the given scratch area as working memory, filling in
+ * its score and, in fixed point, its cost.
+ * @param answers The survivors packed for the feedback kernel, or NULL to use the pattern matrix.
+ * @param patterns Kernel output buffer of answers->padded entries (unused with the pattern matrix).
+ */
+static void score_guess(const Solver *solver, GuessChoice *choice, const CandidateSet *candidates,
+                        const AnswerBlock *answers, Pattern *patterns, WorkerScratch *scratch, const Scoring *scoring)
+{
+    if (scoring->nlog2n == NULL)
+    {
+        if (solver->prior.weights != NULL)
+        {
+            choice->score = score_weighted(solver, choice->guess, candidates, answers, patterns, scratch,
+                                           scoring->total_weight);
+            return;
+        }
+        fill_histogram(solver, choice->guess, candidates, answers, patterns, scratch);
+        choice->score = histogram_entropy(scratch->histogram, candidates->count);
+        return;
+    }
+    fill_histogram(solver, choice->guess, candidates, answers, patterns, scratch);
+    choice->cost = histogram_cost(scoring->nlog2n, scratch->histogram);
+    choice->score = cost_entropy(choice->cost, candidates->count);
+}
+
+/**
+ * Sums the prior weights of the survivors (their count without a prior).
+ */
+static double candidates_weight(const Solver *solver, const CandidateSet *candidates)
+{
+    if (solver->prior.weights == NULL)
+    {
+        return candidates->count;
+    }
+    double total = 0.0;
+    for (int i = 0; i < candidates->count; i++)
+    {
+        total += solver->prior.weights[candidates->index[i]];
+    }
+    return total;
+}
+
+/**
+ * Prepares the scoring of one decision: in fixed point without a prior, in floating point with one.
+ */
+static Scoring scoring_init(const Solver *solver, const CandidateSet *candidates)
+{
+    Scoring scoring;
+    scoring.nlog2n = solver->prior.weights == NULL ? solver->nlog2n : NULL;
+    scoring.tolerance = (uint64_t)(ENTROPY_EPSILON * candidates->count * (double)(1ull << ENTROPY_FIXED_BITS));
+    scoring.total_weight = candidates_weight(solver, candidates);
+    return scoring;
+}
+
+/**
+ * Computes the expected information of a guess over the surviving candidates,
+ * in floating point. This is the reference for the fixed-point scoring.
+ * @param solver The solver holding the dictionary and pattern matrix.
+ * @param guess Dictionary index of the guess to score.
+ * @param candidates The surviving candidates (possible answers).
+ * @return The expected information in bits.
+ */
+double entropy_score(const Solver *solver, int guess, const CandidateSet *candidates)
+{
+    WorkerScratch scratch;
+    Scoring scoring = scoring_init(solver, candidates);
+    scoring.nlog2n = NULL;
+    GuessChoice choice = {guess, 0.0, 0, 0};
+    score_guess(solver, &choice, candidates, NULL, NULL, &scratch, &scoring);
+    return choice.score;
+}
+
+/**
+ * Computes the fixed-point cost of a guess over the surviving candidates,
+ * the sum of n * log2(n) over its pattern buckets scaled by 2^ENTROPY_FIXED_BITS.
+ * The prior is ignored.
+ * @param solver The solver holding the dictionary, pattern matrix and n * log2(n) table.
+ * @param guess Dictionary index of the guess to score.
+ * @param candidates The surviving candidates (possible answers).
+ * @return The cost, lower being better.
+ */
+uint64_t entropy_cost(const Solver *solver, int guess, const CandidateSet *candidates)
+{
+    WorkerScratch scratch;
+    fill_histogram(solver, guess, candidates, NULL, NULL, &scratch);
+    return histogram_cost(solver->nlog2n, scratch.histogram);
+}
+
+/**
+ * Orders scored guesses: higher score first, then words that can still be the
+ * answer, then the earliest word. The order does not depend on which guesses
+ * were compared first, so any split of the work picks the same guess.
+ * @return 1 if a is better than b, 0 otherwise.
+ */
+int choice_better(const GuessChoice *a, const GuessChoice *b)
+{
+    if (b->guess < 0)
+    {
+        return a->guess >= 0;
+    }
+    if (a->guess < 0)
+    {
+        return 0;
+    }
+    if (a->score > b->score + ENTROPY_EPSILON)
+    {
+        return 1;
+    }
+    if (b->score > a->score + ENTROPY_EPSILON)
+    {
+        return 0;
+    }
+    if (a->is_candidate != b->is_candidate)
+    {
+        return a->is_candidate;
+    }
+    return a->guess < b->guess;
+}
+
+/**
+ * Orders scored guesses like choice_better(), comparing the integer costs when
+ * scored in fixed point.
+ */
+static int scored_better(const Scoring *scoring, const GuessChoice *a, const GuessChoice *b)
+{
+    if (scoring->nlog2n == NULL || a->guess < 0 || b->guess < 0)
+    {
+        return choice_better(a, b);
+    }
+    if (a->cost + scoring->tolerance < b->cost)
+    {
+        return 1;
+    }
+    if (b->cost + scoring->tolerance < a->cost)
+    {
+        return 0;
+    }
+    if (a->is_candidate != b->is_candidate)
+    {
+        return a->is_candidate;
+    }
+    return a->guess < b->guess;
+}
+
+/**
+ * Binary entropy of a probability, in bits.
+ */
+static double binary_entropy(double p)
+{
+    if (p <= 0.0 || p >= 1.0)
+    {
+        return 0.0;
+    }
+    return -p * log2(p) - (1.0 - p) * log2(1.0 - p);
+}
+
+/**
+ * Computes, for every (position, letter) pair, an upper bound on the
+ * information of the mark at that position over the survivors.
+ *
+ * If the guess does not repeat the letter, the mark is exactly known from
+ * position and presence counts: green if the answer has the letter there,
+ * yellow if it has it elsewhere only, gray otherwise. With a repeated letter,
+ * yellow and gray can split either way, so the bound counts the green/other
+ * split plus one bit for the rest.
+ * @param unique Receives the bounds for a letter that appears once in the guess.
+ * @param repeated Receives the bounds for a letter that appears more than once.
+ */
+static void position_bounds(const Solver *solver, const CandidateSet *candidates, double total_weight,
+                            double unique[WORD_LEN][ALPHABET_SIZE], double repeated[WORD_LEN][ALPHABET_SIZE])
+{
+    double at[WORD_LEN][ALPHABET_SIZE] = {{0}}; // Weight of the answers with the letter at the position
+    double in[ALPHABET_SIZE] = {0};             // Weight of the answers containing the letter
+    const double *weights = solver->prior.weights;
+    for (int i = 0; i < candidates->count; i++)
+    {
+        const DictWord *answer = &solver->dict.words[candidates->index[i]];
+        double weight = weights != NULL ? weights[candidates->index[i]] : 1.0;
+        for (int p = 0; p < WORD_LEN; p++)
+        {
+            at[p][answer->codes[p]] += weight;
+        }
+        uint32_t letters = answer->mask;
+        while (letters != 0)
+        {
+            in[__builtin_ctz(letters)] += weight;
+            letters &= letters - 1;
+        }
+    }
+
+    for (int p = 0; p < WORD_LEN; p++)
+    {
+        for (int c = 0; c < ALPHABET_SIZE; c++)
+        {
+            double green = at[p][c] / total_weight;
+            double yellow = (in[c] - at[p][c]) / total_weight;
+            double gray = 1.0 - green - yellow;
+            double sum = 0.0;
+            if (green > 0.0)
+            {
+                sum -= green * log2(green);
+            }
+            if (yellow > 0.0)
+            {
+                sum -= yellow * log2(yellow);
+            }
+            if (gray > 0.0)
+            {
+                sum -= gray * log2(gray);
+            }
+            unique[p][c] = sum;
+            repeated[p][c] = binary_entropy(green) + (1.0 - green);
+        }
+    }
+}
+
+#define RANK_BOUND_BITS 12                        // Fractional bits of the sorted bounds
+#define RANK_BOUND_MAX (16ull << RANK_BOUND_BITS) // Above every bound, which is at most log2(NUM_PATTERNS) < 13
+
+/**
+ * A guess with an upper bound on its score.
+ */
+typedef struct
+{
+    double bound;
+    int guess;
+    int is_candidate;
+} RankedGuess;
+
+/**
+ * Sorts 64-bit keys in increasing order, a byte at a time (LSD radix sort).
+ * Bytes that are the same in every key are skipped.
+ * @param keys The keys to sort.
+ * @param tmp Working memory of count keys.
+ */
+static void radix_sort(uint64_t *keys, uint64_t *tmp, int count)
+{
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        int offsets[256] = {0};
+        for (int i = 0; i < count; i++)
+        {
+            offsets[(keys[i] >> shift) & 0xff]++;
+        }
+        if (count == 0 || offsets[(keys[0] >> shift) & 0xff] == count)
+        {
+            continue;
+        }
+        int sum = 0;
+        for (int b = 0; b < 256; b++)
+        {
+            int size = offsets[b];
+            offsets[b] = sum;
+            sum += size;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            tmp[offsets[(keys[i] >> shift) & 0xff]++] = keys[i];
+        }
+        memcpy(keys, tmp, count * sizeof(uint64_t));
+    }
+}
+
+/**
+ * Bounds the score of every dictionary word and sorts them by decreasing bound.
+ *
+ * The information of the whole pattern is at most the sum of the information
+ * of the marks at each position (entropy is subadditive), and at most log2 of
+ * the number of patterns that can occur.
+ *
+ * Bounds are rounded up to RANK_BOUND_BITS fractional bits, and the (bound,
+ * index) pairs are radix sorted as 64-bit keys: sorting with qsort() took
+ * longer than scoring the guesses that survive the pruning.
+ * @param ranked Receives the dict.num_words ranked guesses.
+ */
+static void rank_guesses(const Solver *solver, const CandidateSet *candidates, double total_weight, RankedGuess *ranked)
+{
+    double unique[WORD_LEN][ALPHABET_SIZE];
+    double repeated[WORD_LEN][ALPHABET_SIZE];
+    position_bounds(solver, candidates, total_weight, unique, repeated);
+    double cap = log2((double)(candidates->count < NUM_PATTERNS ? candidates->count : NUM_PATTERNS));
+
+    int num_words = solver->dict.num_words;
+    uint64_t *keys = (uint64_t *)malloc(2 * (num_words > 0 ? num_words : 1) * sizeof(uint64_t));
+    uint8_t *is_candidate = (uint8_t *)calloc(num_words > 0 ? num_words : 1, 1);
+    if (keys == NULL || is_candidate == NULL)
+    {
+        // Unsorted, every bound is the cap, so nothing is pruned
+        for (int g = 0; g < num_words; g++)
+        {
+            ranked[g].bound = cap;
+            ranked[g].guess = g;
+            ranked[g].is_candidate = 0;
+        }
+        for (int i = 0; i < candidates->count; i++)
+        {
+            ranked[candidates->index[i]].is_candidate = 1;
+        }
+        free(keys);
+        free(is_candidate);
+        return;
+    }
+    for (int i = 0; i < candidates->count; i++)
+    {
+        is_candidate[candidates->index[i]] = 1;
+    }
+
+    for (int g = 0; g < num_words; g++)
+    {
+        const DictWord *word = &solver->dict.words[g];
+        // Positions whose letter appears elsewhere in the word too
+        int repeats = 0;
+        for (int p = 0; p < WORD_LEN; p++)
+        {
+            for (int q = p + 1; q < WORD_LEN; q++)
+            {
+                if (word->codes[p] == word->codes[q])
+                {
+                    repeats |= 1 << p | 1 << q;
+                }
+            }
+        }
+        double bound = 0.0;
+        for (int p = 0; p < WORD_LEN; p++)
+        {
+            bound += repeats & 1 << p ? repeated[p][word->codes[p]] : unique[p][word->codes[p]];
+        }
+        bound = bound < cap ? bound : cap;
+
+        // Rounded up to RANK_BOUND_BITS fractional bits, complemented so the keys sort by decreasing bound
+        uint64_t quantized = (uint64_t)ceil(bound * (1 << RANK_BOUND_BITS));
+        keys[g] = (RANK_BOUND_MAX - quantized) << 32 | (uint32_t)g;
+    }
+    radix_sort(keys, keys + num_words, num_words);
+
+    for (int k = 0; k < num_words; k++)
+    {
+        ranked[k].bound = (double)(RANK_BOUND_MAX - (keys[k] >> 32)) / (1 << RANK_BOUND_BITS);
+        ranked[k].guess = (int)(uint32_t)keys[k];
+        ranked[k].is_candidate = is_candidate[ranked[k].guess];
+    }
+    free(keys);
+    free(is_candidate);
+}
+
+/**
+ * Scores every num_workers-th ranked guess starting at first, in bound order,
+ * and returns the best of them. The scan stops at the first guess whose bound
+ * cannot even tie the best score so far, since no later guess can either.
+ * With a deadline, it also stops once the deadline has passed.
+ */
+static GuessChoice scan_guesses(const Solver *solver, const CandidateSet *candidates, const AnswerBlock *answers,
+                                const Scoring *scoring, const RankedGuess *ranked, int first, int num_workers,
+                                WorkerScratch *scratch, Deadline *deadline)
+{
+    GuessChoice best = {-1, 0.0, 0, 0};
+    Pattern *patterns = answers != NULL ? (Pattern *)aligned_alloc(32, answers->padded * sizeof(Pattern)) : NULL;
+    if (patterns == NULL)
+    {
+        answers = NULL; // Computes each pattern on its own
+    }
+
+    int scored = 0;
+    for (int k = first; k < solver->dict.num_words; k += num_workers)
+    {
+        // The bound is computed differently from the score, so allow for rounding
+        if (best.guess >= 0 && ranked[k].bound + ENTROPY_EPSILON < best.score - ENTROPY_EPSILON)
+        {
+            break;
+        }
+        if (++scored % DEADLINE_CHECK_INTERVAL == 0 && deadline_passed(deadline))
+        {
+            break;
+        }
+
+        GuessChoice choice = {ranked[k].guess, 0.0, ranked[k].is_candidate, 0};
+        score_guess(solver, &choice, candidates, answers, patterns, scratch, scoring);
+        if (scored_better(scoring, &choice, &best))
+        {
+            best = choice;
+        }
+    }
+    free(patterns);
+    return best;
+}
+
+/**
+ * Finds the words that are not survivors with the highest expected information,
+ * such as probe words that split the survivors without being able to win.
+ * Like entropy_best_guess(), the words are scored in bound order, and the scan
+ * stops once no bound can beat the last of the best words so far.
+ * @param solver The solver holding the dictionary and pattern matrix.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @param max The number of words wanted.
+ * @param guesses Receives the words, best first.
+ * @param deadline When to give up, or NULL for no limit.
+ * @return The number of words written, or -1 if the deadline passed first.
+ */
+int entropy_best_probes(const Solver *solver, const CandidateSet *candidates, int max, int *guesses, Deadline *deadline)
+{
+    Scoring scoring = scoring_init(solver, candidates);
+    RankedGuess *ranked = (RankedGuess *)malloc(solver->dict.num_words * sizeof(RankedGuess));
+    GuessChoice *top = (GuessChoice *)malloc((max > 0 ? max : 1) * sizeof(GuessChoice));
+    if (ranked == NULL || top == NULL)
+    {
+        free(ranked);
+        free(top);
+        return 0;
+    }
+    rank_guesses(solver, candidates, scoring.total_weight, ranked);
+
+    WorkerScratch scratch;
+    int num_top = 0;
+    int scored = 0;
+    int expired = 0;
+    for (int k = 0; k < solver->dict.num_words && max > 0; k++)
+    {
+        if (ranked[k].is_candidate)
+        {
+            continue;
+        }
+        if (num_top == max && ranked[k].bound + ENTROPY_EPSILON < top[num_top - 1].score - ENTROPY_EPSILON)
+        {
+            break;
+        }
+        if (++scored % DEADLINE_CHECK_INTERVAL == 0 && deadline_passed(deadline))
+        {
+            expired = 1;
+            break;
+        }
+
+        // Insert into the sorted top list
+        GuessChoice choice = {ranked[k].guess, 0.0, 0, 0};
+        score_guess(solver, &choice, candidates, NULL, NULL, &scratch, &scoring);
+        if (num_top == max && !scored_better(&scoring, &choice, &top[num_top - 1]))
+        {
+            continue;
+        }
+        int i = num_top < max ? num_top++ : num_top - 1;
+        while (i > 0 && scored_better(&scoring, &choice, &top[i - 1]))
+        {
+            top[i] = top[i - 1];
+            i--;
+        }
+        top[i] = choice;
+    }
+
+    for (int i = 0; i < num_top; i++)
+    {
+        guesses[i] = top[i].guess;
+    }
+    free(ranked);
+    free(top);
+    return expired ? -1 : num_top;
+}
+
+typedef struct
+{
+    const Solver *solver;
+    const CandidateSet *candidates;
+    const AnswerBlock *answers;
+    const Scoring *scoring;
+    const RankedGuess *ranked;
+    Deadline *deadline;
+} ScanTask;
+
+/**
+ * Pool task: the workers take the ranked guesses in turn, so each one starts
+ * with guesses of high bound and prunes on its own best score.
+ */
+static void scan_shard(void *arg, int worker, int num_workers, WorkerScratch *scratch)
+{
+    ScanTask *task = (ScanTask *)arg;
+    scratch->best = scan_guesses(task->solver, task->candidates, task->answers, task->scoring, task->ranked, worker,
+                                 num_workers, scratch, task->deadline);
+}
+
+/**
+ * Picks the guess for two survivors or fewer, which needs no scoring: guessing
+ * a survivor is at least as good as anything else, and the likelier one is best.
+ * @return Dictionary index of the guess, or -1 if there are no candidates.
+ */
+static int survivor_pick(const Solver *solver, const CandidateSet *candidates)
+{
+    if (candidates->count == 0)
+    {
+        return -1;
+    }
+    const double *weights = solver->prior.weights;
+    if (candidates->count == 2 && weights != NULL && weights[candidates->index[1]] > weights[candidates->index[0]])
+    {
+        return candidates->index[1];
+    }
+    return candidates->index[0];
+}
+
+/**
+ * Picks the dictionary word with the highest expected information.
+ * Ties go to a word that can still be the answer, then to the earliest word.
+ * Guesses are scored in order of an upper bound on their score, and the scan
+ * stops once no remaining bound can beat the best score found, which picks the
+ * same guess as scoring every word. When the solver has a worker pool, the
+ * ranked guesses are dealt out to the workers in turn.
+ * @param solver The solver holding the dictionary, pattern matrix and worker pool.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @param deadline When to stop scoring and settle for the best guess so far, or NULL to score every word.
+ *                 If nothing was scored by then, the first survivor is returned.
+ * @return Dictionary index of the best guess, or -1 if there are no candidates.
+ */
+int entropy_best_guess(const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    if (candidates->count <= 2)
+    {
+        return survivor_pick(solver, candidates);
+    }
+
+    // Without the pattern matrix, pack the survivors once for the feedback kernel, or else compute each pattern
+    AnswerBlock block;
+    const AnswerBlock *answers = NULL;
+    if (solver->matrix.data == NULL && answer_block_init(&block, &solver->dict, candidates->index, candidates->count) == 0)
+    {
+        answers = &block;
+    }
+
+    // Score the guesses with the highest bounds first, and stop once no bound can beat the best score
+    Scoring scoring = scoring_init(solver, candidates);
+    RankedGuess *ranked = (RankedGuess *)malloc(solver->dict.num_words * sizeof(RankedGuess));
+    if (ranked == NULL)
+    {
+        if (answers != NULL)
+        {
+            answer_block_free(&block);
+        }
+        return candidates->index[0];
+    }
+    rank_guesses(solver, candidates, scoring.total_weight, ranked);
+
+    GuessChoice best = {-1, 0.0, 0, 0};
+    if (solver->pool == NULL)
+    {
+        WorkerScratch scratch;
+        best = scan_guesses(solver, candidates, answers, &scoring, ranked, 0, 1, &scratch, deadline);
+    }
+    else
+    {
+        ScanTask task = {solver, candidates, answers, &scoring, ranked, deadline};
+        pool_run(solver->pool, scan_shard, &task);
+
+        // Reduce the per-worker results
+        WorkerScratch *scratch = pool_scratch(solver->pool);
+        for (int w = 0; w < pool_size(solver->pool); w++)
+        {
+            if (scored_better(&scoring, &scratch[w].best, &best))
+            {
+                best = scratch[w].best;
+            }
+        }
+    }
+
+    free(ranked);
+    if (answers != NULL)
+    {
+        answer_block_free(&block);
+    }
+
+    // The cheapest guess that can win, when the deadline left no time to score anything
+    return best.guess != -1 ? best.guess : candidates->index[0];
+}
+
+#define BATCH_CHUNK 64 // Ranked guesses each decision of a batch takes per pass
+
+/**
+ * One decision of a batch: its survivors, its ranked guesses and how far it got.
+ */
+typedef struct
+{
+    const CandidateSet *candidates;
+    Scoring scoring;
+    RankedGuess *ranked;
+    int next; // Next ranked guess to take, dict.num_words once pruned
+    GuessChoice best;
+} BatchDecision;
+
+/**
+ * One pass of a batch: the (guess, decision) keys to score, sorted by guess,
+ * and the best guess each worker found for each decision.
+ */
+typedef struct
+{
+    const Solver *solver;
+    BatchDecision *decisions;
+    int count;
+    const uint64_t *keys;
+    int num_keys;
+    GuessChoice *best; // num_workers rows of count entries
+} BatchPass;
+
+/**
+ * Moves a key position forward to the first key of a guess, so that every
+ * guess of a pass, and its pattern matrix row, goes to one worker.
+ */
+static int batch_boundary(const BatchPass *pass, int k)
+{
+    while (k > 0 && k < pass->num_keys && pass->keys[k] >> 32 == pass->keys[k - 1] >> 32)
+    {
+        k++;
+    }
+    return k;
+}
+
+/**
+ * Pool task: each worker scores a contiguous run of the pass's guesses for
+ * every decision that takes them.
+ */
+static void batch_shard(void *arg, int worker, int num_workers, WorkerScratch *scratch)
+{
+    BatchPass *pass = (BatchPass *)arg;
+    int begin = batch_boundary(pass, (int)((int64_t)pass->num_keys * worker / num_workers));
+    int end = batch_boundary(pass, (int)((int64_t)pass->num_keys * (worker + 1) / num_workers));
+    GuessChoice *best = &pass->best[(size_t)worker * pass->count];
+    for (int d = 0; d < pass->count; d++)
+    {
+        best[d].guess = -1;
+    }
+    for (int k = begin; k < end; k++)
+    {
+        int d = (int)((uint32_t)pass->keys[k] >> 1);
+        BatchDecision *decision = &pass->decisions[d];
+        GuessChoice choice = {(int)(pass->keys[k] >> 32), 0.0, (int)(pass->keys[k] & 1), 0};
+        score_guess(pass->solver, &choice, decision->candidates, NULL, NULL, scratch, &decision->scoring);
+        if (scored_better(&decision->scoring, &choice, &best[d]))
+        {
+            best[d] = choice;
+        }
+    }
+}
+
+/**
+ * Picks the best guess of several survivor sets at once, as entropy_best_guess()
+ * would pick it for each of them without a deadline.
+ *
+ * In every pass, each decision takes its next BATCH_CHUNK ranked guesses whose
+ * bound can still beat its best score. The (guess, decision) pairs of the pass
+ * are sorted by guess and scored in that order, so the decisions that score the
+ * same guess do so one after the other, from one pattern matrix row. With a
+ * worker pool, the sorted pairs are split into runs of whole guesses, one per
+ * worker, so each row is still read by one worker only. A decision may score
+ * a few guesses past the point where entropy_best_guess() would stop, but
+ * their bounds are below its best score, so they cannot change the pick.
+ * @param solver The solver holding the dictionary, pattern matrix and worker pool.
+ * @param sets The survivor sets, each in dictionary order.
+ * @param count The number of sets.
+ * @param guesses Receives the best guess of each set, -1 for an empty set.
+ * @return The number of pattern matrix rows read, once per guess and pass
+ *         whatever the number of decisions scoring it, or -1 if the sets were
+ *         decided one by one.
+ *
+ * Note: Without the pattern matrix, or if the batch cannot be allocated, the
+ * sets are decided one by one.
+ */
+int entropy_best_guesses(const Solver *solver, const CandidateSet *const *sets, int count, int *guesses)
+{
+    int num_words = solver->dict.num_words;
+    int num_workers = solver->pool != NULL ? pool_size(solver->pool) : 1;
+    BatchDecision *decisions = (BatchDecision *)calloc(count > 0 ? count : 1, sizeof(BatchDecision));
+    uint64_t *keys = (uint64_t *)malloc(2 * ((size_t)count * BATCH_CHUNK + 1) * sizeof(uint64_t));
+    GuessChoice *best = (GuessChoice *)malloc((size_t)num_workers * (count > 0 ? count : 1) * sizeof(GuessChoice));
+    if (solver->matrix.data == NULL || decisions == NULL || keys == NULL || best == NULL)
+    {
+        for (int d = 0; d < count; d++)
+        {
+            guesses[d] = entropy_best_guess(solver, sets[d], NULL);
+        }
+        free(decisions);
+        free(keys);
+        free(best);
+        return -1;
+    }
+
+    // Sets of two survivors or fewer need no scoring
+    for (int d = 0; d < count; d++)
+    {
+        BatchDecision *decision = &decisions[d];
+        decision->candidates = sets[d];
+        decision->next = num_words;
+        decision->best.guess = -1;
+        if (sets[d]->count <= 2)
+        {
+            continue;
+        }
+        decision->scoring = scoring_init(solver, sets[d]);
+        decision->ranked = (RankedGuess *)malloc(num_words * sizeof(RankedGuess));
+        if (decision->ranked != NULL)
+        {
+            rank_guesses(solver, sets[d], decision->scoring.total_weight, decision->ranked);
+            decision->next = 0;
+        }
+    }
+
+    WorkerScratch scratch;
+    int rows = 0;
+    for (;;)
+    {
+        // Keys are (guess, decision, is_candidate), so sorting them groups the decisions by guess
+        int num_keys = 0;
+        for (int d = 0; d < count; d++)
+        {
+            BatchDecision *decision = &decisions[d];
+            for (int taken = 0; taken < BATCH_CHUNK && decision->next < num_words; taken++)
+            {
+                const RankedGuess *ranked = &decision->ranked[decision->next];
+                if (decision->best.guess >= 0 && ranked->bound + ENTROPY_EPSILON < decision->best.score - ENTROPY_EPSILON)
+                {
+                    decision->next = num_words;
+                    break;
+                }
+                keys[num_keys++] = (uint64_t)ranked->guess << 32 | (uint64_t)d << 1 | (uint64_t)ranked->is_candidate;
+                decision->next++;
+            }
+        }
+        if (num_keys == 0)
+        {
+            break;
+        }
+        radix_sort(keys, keys + num_keys, num_keys);
+        for (int k = 0; k < num_keys; k++)
+        {
+            rows += k == 0 || keys[k] >> 32 != keys[k - 1] >> 32;
+        }
+
+        BatchPass pass = {solver, decisions, count, keys, num_keys, best};
+        if (solver->pool != NULL)
+        {
+            pool_run(solver->pool, batch_shard, &pass);
+        }
+        else
+        {
+            batch_shard(&pass, 0, 1, &scratch);
+        }
+
+        // Reduce the per-worker results, which cover increasing guesses
+        for (int w = 0; w < num_workers; w++)
+        {
+            for (int d = 0; d < count; d++)
+            {
+                if (scored_better(&decisions[d].scoring, &best[(size_t)w * count + d], &decisions[d].best))
+                {
+                    decisions[d].best = best[(size_t)w * count + d];
+                }
+            }
+        }
+    }
+
+    for (int d = 0; d < count; d++)
+    {
+        BatchDecision *decision = &decisions[d];
+        if (sets[d]->count <= 2)
+        {
+            guesses[d] = survivor_pick(solver, sets[d]);
+        }
+        else if (decision->ranked == NULL)
+        {
+            guesses[d] = entropy_best_guess(solver, sets[d], NULL);
+        }
+        else
+        {
+            guesses[d] = decision->best.guess != -1 ? decision->best.guess : sets[d]->index[0];
+        }
+        free(decision->ranked);
+    }
+    free(decisions);
+    free(keys);
+    free(best);
+    return rows;
+}
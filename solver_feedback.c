@@ -0,0 +1,85 @@
+/**
+ * Feedback Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file computes the marks the server would return for a guess against a
+ * given secret, encoded as a single base-3 pattern code:
+ *
+ *     pattern = marks[0] * 3^0 + marks[1] * 3^1 + ... + marks[WORD_LEN - 1] * 3^(WORD_LEN - 1)
+ *
+ * Repeated letters follow the server's rules: green marks are assigned first,
+ * then each remaining guess letter (left to right) is marked yellow only while
+ * the secret still has an unmatched copy of it.
+ */
+
+#include "solver.h"
+
+static const int POW3[8] = {1, 3, 9, 27, 81, 243, 729, 2187}; // Up to 3^(WORD_LEN - 1)
+
+/**
+ * Computes the feedback pattern for a guess against a secret word.
+ * @param guess The guessed word.
+ * @param answer The secret word.
+ * @return The pattern code, between 0 and NUM_PATTERNS - 1.
+ */
+int feedback_pattern(const DictWord *guess, const DictWord *answer)
+{
+    uint8_t unmatched[ALPHABET_SIZE]; // Secret letters not consumed by a green mark
+    int pattern = 0;
+    int green = 0;
+
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        unmatched[answer->codes[i]] = 0;
+    }
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        if (guess->codes[i] == answer->codes[i])
+        {
+            pattern += 2 * POW3[i];
+            green |= 1 << i;
+        }
+        else
+        {
+            unmatched[answer->codes[i]]++;
+        }
+    }
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        uint8_t code = guess->codes[i];
+        if (!(green & (1 << i)) && (answer->mask & LETTER_BIT(code)) && unmatched[code] > 0)
+        {
+            unmatched[code]--;
+            pattern += POW3[i];
+        }
+    }
+    return pattern;
+}
+
+/**
+ * Encodes per-position marks as a pattern code.
+ * @param marks The marks for each position (0, 1 or 2).
+ * @return The pattern code.
+ */
+int pattern_from_marks(const int *marks)
+{
+    int pattern = 0;
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        pattern += marks[i] * POW3[i];
+    }
+    return pattern;
+}
+
+/**
+ * Decodes a pattern code into per-position marks.
+ * @param pattern The pattern code.
+ * @param marks The array receiving the mark for each position.
+ */
+void pattern_to_marks(int pattern, int *marks)
+{
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        marks[i] = pattern % 3;
+        pattern /= 3;
+    }
+}
@@ -0,0 +1,219 @@
+/**
+ * Positional Frequency Strategy for the 3700.network Project - Client Word Solver
+ *
+ * A middle ground between first-fit and entropy scoring: the next guess is the
+ * survivor whose letters are the most common at their positions among the
+ * survivors,
+ *
+ *     score(w) = sum over positions i of count(i, w[i])
+ *
+ * where count(i, c) is the number of survivors with letter c at position i.
+ * A survivor that shares its letters with many others is likely to be the
+ * answer or, when it is not, to rule many others out. No pattern is computed.
+ *
+ * A game keeps the counts up to date instead of recounting them for every
+ * decision: each response takes the words it eliminated off the counts, or,
+ * when fewer words survive than were eliminated, the survivors are counted
+ * afresh, whichever touches fewer words. A decision is then a single pass
+ * over the survivors.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The per-game state: the letter counts and the survivors they cover.
+ */
+typedef struct
+{
+    int counts[WORD_LEN][ALPHABET_SIZE];
+    int *index; // The survivors counted, in dictionary order
+    int count;  // -1 when the index could not hold them
+    int capacity;
+} FrequencyState;
+
+/**
+ * Adds delta to the counts of a word's letters.
+ */
+static inline void count_word(FrequencyState *freq, const DictWord *word, int delta)
+{
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        freq->counts[i][word->codes[i]] += delta;
+    }
+}
+
+/**
+ * Counts a survivor set from scratch.
+ */
+static void count_all(FrequencyState *freq, const Dictionary *dict, const CandidateSet *candidates)
+{
+    memset(freq->counts, 0, sizeof(freq->counts));
+    for (int k = 0; k < candidates->count; k++)
+    {
+        count_word(freq, &dict->words[candidates->index[k]], 1);
+    }
+    if (candidates->count > freq->capacity)
+    {
+        int *index = (int *)realloc(freq->index, candidates->count * sizeof(int));
+        if (index == NULL)
+        {
+            freq->count = -1; // Counted, but recounted at the next response
+            return;
+        }
+        freq->index = index;
+        freq->capacity = candidates->count;
+    }
+    memcpy(freq->index, candidates->index, candidates->count * sizeof(int));
+    freq->count = candidates->count;
+}
+
+/**
+ * Picks the survivor with the highest score under a set of counts.
+ */
+static int best_by_counts(int counts[WORD_LEN][ALPHABET_SIZE], const Dictionary *dict, const CandidateSet *candidates)
+{
+    int best = -1;
+    int best_score = -1;
+    for (int k = 0; k < candidates->count; k++)
+    {
+        const DictWord *word = &dict->words[candidates->index[k]];
+        int score = 0;
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            score += counts[i][word->codes[i]];
+        }
+        if (score > best_score)
+        {
+            best = candidates->index[k];
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+/**
+ * Sets up the counts of a game from its survivors.
+ * @param state Receives the per-game state.
+ * @param solver The solver holding the dictionary.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @return 0 on success, -1 if the state cannot be allocated.
+ */
+int frequency_init(void **state, const Solver *solver, const CandidateSet *candidates)
+{
+    // The survivors only shrink, so the index rarely outgrows them
+    FrequencyState *freq = (FrequencyState *)malloc(sizeof(FrequencyState));
+    if (freq == NULL)
+    {
+        return -1;
+    }
+    freq->capacity = candidates->count > 0 ? candidates->count : 1;
+    freq->index = (int *)malloc(freq->capacity * sizeof(int));
+    if (freq->index == NULL)
+    {
+        free(freq);
+        return -1;
+    }
+    count_all(freq, &solver->dict, candidates);
+    *state = freq;
+    return 0;
+}
+
+/**
+ * Takes the words a response eliminated off the counts.
+ * @param state The per-game state.
+ * @param solver The solver holding the dictionary.
+ * @param guess Dictionary index of the guess (unused).
+ * @param pattern Feedback pattern of the guess (unused).
+ * @param candidates The survivors after the response, a subset of those counted.
+ */
+void frequency_observe(void *state, const Solver *solver, int guess, int pattern, const CandidateSet *candidates)
+{
+    (void)guess;
+    (void)pattern;
+    FrequencyState *freq = (FrequencyState *)state;
+    const Dictionary *dict = &solver->dict;
+    if (candidates->count < freq->count - candidates->count)
+    {
+        count_all(freq, dict, candidates);
+        return;
+    }
+
+    // Both lists are in dictionary order, so one merge pass finds the eliminated words
+    int kept = 0;
+    for (int k = 0; k < freq->count; k++)
+    {
+        int word = freq->index[k];
+        if (kept < candidates->count && candidates->index[kept] == word)
+        {
+            kept++;
+        }
+        else
+        {
+            count_word(freq, &dict->words[word], -1);
+        }
+    }
+    if (kept != candidates->count)
+    {
+        // Not a subset of the words counted
+        count_all(freq, dict, candidates);
+        return;
+    }
+    memcpy(freq->index, candidates->index, candidates->count * sizeof(int));
+    freq->count = candidates->count;
+}
+
+/**
+ * Picks the survivor with the highest positional frequency score.
+ * @param state The per-game state.
+ * @param solver The solver holding the dictionary.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @param deadline Unused; a decision is a single pass over the survivors.
+ * @return Dictionary index of the earliest best survivor, or -1 if there are none.
+ */
+int frequency_next_guess(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    (void)deadline;
+    FrequencyState *freq = (FrequencyState *)state;
+    if (freq->count != candidates->count)
+    {
+        count_all(freq, &solver->dict, candidates);
+    }
+    return best_by_counts(freq->counts, &solver->dict, candidates);
+}
+
+/**
+ * Releases the per-game state.
+ */
+void frequency_destroy(void *state)
+{
+    FrequencyState *freq = (FrequencyState *)state;
+    if (freq != NULL)
+    {
+        free(freq->index);
+        free(freq);
+    }
+}
+
+/**
+ * Picks the survivor with the highest positional frequency score, counting the
+ * survivors from scratch. This is the reference for the incremental counts.
+ * @param solver The solver holding the dictionary.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @return Dictionary index of the earliest best survivor, or -1 if there are none.
+ */
+int frequency_best_guess(const Solver *solver, const CandidateSet *candidates)
+{
+    int counts[WORD_LEN][ALPHABET_SIZE];
+    memset(counts, 0, sizeof(counts));
+    for (int k = 0; k < candidates->count; k++)
+    {
+        const DictWord *word = &solver->dict.words[candidates->index[k]];
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            counts[i][word->codes[i]]++;
+        }
+    }
+    return best_by_counts(counts, &solver->dict, candidates);
+}
@@ -0,0 +1,480 @@
+/**
+ * Game State Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file ties the pieces of the solver together for one game: it folds each
+ * response into the constraint state, narrows the surviving candidates, follows
+ * the opening book while the game is still in it, and otherwise asks the
+ * selected strategy for the next guess. The strategy's per-game state is set up
+ * when it makes its first decision and follows every response after that.
+ * Decisions outside the book are shared with the other games of the process
+ * through the decision table, and with later runs through the decision cache
+ * file, when the strategy allows it (STRATEGY_SHARED).
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Starts a new game.
+ * @param game The game state to initialize.
+ * @param solver The solver holding the dictionary and opening book.
+ * @return 0 on success, -1 if the survivors cannot be allocated. The game then has none.
+ *
+ * Note: The caller must release the game state with game_free(), in either case.
+ */
+int game_init(GameState *game, const Solver *solver)
+{
+    constraint_init(&game->constraint);
+    int result = candidates_init(&game->candidates, &solver->dict);
+    game->book_node = solver->book.nodes != NULL ? 0 : -1;
+    game->num_guesses = 0;
+    game->budget_us = 0;
+    game->budget_hits = 0;
+    game->cancel = NULL;
+    game->num_computed = 0;
+    game->rtt_ns = 0;
+    game->speed = 1.0;
+    game->cheap_picks = 0;
+    game->strategy_ops = NULL;
+    game->strategy_state = NULL;
+    game->last_guess = -1;
+    return result;
+}
+
+/**
+ * Releases the per-game state of the strategy playing a game, if any.
+ */
+static void game_release_strategy(GameState *game)
+{
+    if (game->strategy_ops != NULL && game->strategy_ops->destroy != NULL)
+    {
+        game->strategy_ops->destroy(game->strategy_state);
+    }
+    game->strategy_ops = NULL;
+    game->strategy_state = NULL;
+}
+
+/**
+ * Tells whether the next guess comes from the opening book: the game is still
+ * in the book, and the book was made with this strategy and prior.
+ * @param game The game state.
+ * @param solver The solver.
+ * @param strategy The strategy the game is played with.
+ * @return 1 if the book decides, 0 otherwise.
+ */
+int game_in_book(const GameState *game, const Solver *solver, Strategy strategy)
+{
+    return game->book_node >= 0 && solver->book.strategy == (uint32_t)strategy && solver->book.prior == solver->prior.checksum;
+}
+
+/**
+ * Finds a decision that costs nothing: from the opening book when the game is
+ * in it, then from the decision table when another game already reached this
+ * state.
+ * @param key Receives the decision table key of the game's state, or 0 when
+ *            the strategy's decisions are not shared.
+ * @return Dictionary index of the guess, or -1 if the strategy has to decide.
+ */
+static int game_known_guess(const GameState *game, const Solver *solver, Strategy strategy, uint64_t *key)
+{
+    *key = 0;
+    if (game_in_book(game, solver, strategy))
+    {
+        return (int)solver->book.nodes[game->book_node].guess;
+    }
+    if (solver->table == NULL || !(strategy_ops(strategy)->flags & STRATEGY_SHARED))
+    {
+        return -1;
+    }
+
+    // Decisions made under another prior are not reused
+    *key = constraint_hash(&game->constraint, (uint64_t)solver->prior.checksum << 32 | strategy_key(strategy));
+    return table_lookup(solver->table, *key);
+}
+
+/**
+ * Shares a decision with the other games of the process and with later runs.
+ * @param key The key from game_known_guess(), 0 to keep the decision to the game.
+ */
+static void game_share_guess(const Solver *solver, uint64_t key, int guess)
+{
+    if (key != 0)
+    {
+        table_store(solver->table, key, guess);
+        cache_append(&solver->cache, key, guess);
+    }
+}
+
+/**
+ * Makes the decision of game_next_guess().
+ */
+static int game_decide(GameState *game, const Solver *solver, Strategy strategy)
+{
+    int timed = strategy == STRATEGY_TIMED;
+    if (timed)
+    {
+        strategy = STRATEGY_ENTROPY;
+    }
+
+    uint64_t key;
+    int known = game_known_guess(game, solver, strategy, &key);
+    if (known != -1)
+    {
+        return known;
+    }
+
+    if (timed && game->candidates.count > 0 && !timing_worth_scoring(solver, game))
+    {
+        game->cheap_picks++;
+        return game->candidates.index[0];
+    }
+
+    const StrategyOps *ops = strategy_ops(strategy);
+    if (game->strategy_ops != ops)
+    {
+        game_release_strategy(game);
+        if (ops->init != NULL && ops->init(&game->strategy_state, solver, &game->candidates) == -1)
+        {
+            return -1;
+        }
+        game->strategy_ops = ops;
+    }
+
+    Deadline deadline;
+    deadline_start(&deadline, game->budget_us);
+    deadline.cancel = game->cancel;
+    uint64_t start = timing_now_ns();
+    int guess = game->candidates.count > 0 ? ops->next_guess(game->strategy_state, solver, &game->candidates, &deadline) : -1;
+    game->num_computed++;
+    if (deadline.expired)
+    {
+        game->budget_hits++;
+    }
+    else if (guess != -1)
+    {
+        timing_observe_decision(&solver->timing, game, game->candidates.count, timing_now_ns() - start);
+        game_share_guess(solver, key, guess);
+    }
+    return guess;
+}
+
+/**
+ * Picks the next word to guess, from the opening book when the game is in it,
+ * then from the decision table when another game already reached this state.
+ * With a time budget, the strategy settles for the best guess it found in time;
+ * such a decision is counted in budget_hits and not shared with other games.
+ * A decision abandoned through game->cancel is treated the same way.
+ *
+ * The timed strategy plays the entropy strategy's decisions: from the book and
+ * the table whenever they have one, since those cost nothing, and otherwise
+ * only when the time model expects scoring to save more time than it takes
+ * (solver_timing.c). Elsewhere it guesses the first survivor.
+ * @param game The game state.
+ * @param solver The solver.
+ * @param strategy The strategy used outside the book.
+ * @return Dictionary index of the word to guess, or -1 if no word is left or the
+ *         strategy cannot be set up.
+ */
+int game_next_guess(GameState *game, const Solver *solver, Strategy strategy)
+{
+    int guess = game_decide(game, solver, strategy);
+    game->last_guess = guess;
+    return guess;
+}
+
+/**
+ * Picks the next word to guess for several games at once, as game_next_guess()
+ * would for each of them. With the entropy strategy, the games that need a
+ * full entropy scan are scored in one batch (entropy_best_guesses()), which
+ * reads the pattern matrix once for all of them; every other decision is made
+ * game by game.
+ * @param games The game states.
+ * @param count The number of games.
+ * @param solver The solver.
+ * @param strategy The strategy used outside the book.
+ * @param guesses Receives the guess of each game, -1 if it has no word left.
+ *
+ * Note: Games with a time budget or a cancel flag are decided on their own,
+ * since a batch has no deadline.
+ */
+void game_next_guesses(GameState *const *games, int count, const Solver *solver, Strategy strategy, int *guesses)
+{
+    int *pending = strategy == STRATEGY_ENTROPY ? (int *)malloc((count > 0 ? count : 1) * sizeof(int)) : NULL;
+    const CandidateSet **sets = (const CandidateSet **)malloc((count > 0 ? count : 1) * sizeof(CandidateSet *));
+    uint64_t *keys = (uint64_t *)malloc((count > 0 ? count : 1) * sizeof(uint64_t));
+    if (pending == NULL || sets == NULL || keys == NULL)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            guesses[i] = game_next_guess(games[i], solver, strategy);
+        }
+        free(pending);
+        free(sets);
+        free(keys);
+        return;
+    }
+
+    // The opener and the endgame are decided as the strategy decides them
+    int num_pending = 0;
+    for (int i = 0; i < count; i++)
+    {
+        GameState *game = games[i];
+        int survivors = game->candidates.count;
+        if (game->budget_us > 0 || game->cancel != NULL || survivors <= ENDGAME_MAX_CANDIDATES ||
+            survivors == solver->dict.num_words)
+        {
+            guesses[i] = game_next_guess(game, solver, strategy);
+            continue;
+        }
+        guesses[i] = game_known_guess(game, solver, strategy, &keys[num_pending]);
+        if (guesses[i] == -1)
+        {
+            pending[num_pending] = i;
+            sets[num_pending++] = &game->candidates;
+        }
+    }
+
+    // Games of a batch often reach the same state together, before any of them has stored its decision
+    int *batch = num_pending > 0 ? (int *)malloc(2 * num_pending * sizeof(int)) : NULL;
+    int *same = batch != NULL ? batch + num_pending : NULL; // The first pending game in the same state, or -1
+    int num_sets = 0;
+    for (int k = 0; batch != NULL && k < num_pending; k++)
+    {
+        same[k] = -1;
+        for (int j = 0; j < k && keys[k] != 0 && same[k] == -1; j++)
+        {
+            if (keys[j] == keys[k] && same[j] == -1)
+            {
+                same[k] = j;
+            }
+        }
+        if (same[k] == -1)
+        {
+            sets[num_sets++] = sets[k];
+        }
+    }
+    if (batch != NULL)
+    {
+        entropy_best_guesses(solver, sets, num_sets, batch);
+    }
+
+    // Without the batch, each pending game is decided on its own
+    for (int k = 0, set = 0; k < num_pending; k++)
+    {
+        GameState *game = games[pending[k]];
+        if (batch == NULL)
+        {
+            guesses[pending[k]] = entropy_best_guess(solver, &game->candidates, NULL);
+        }
+        else if (same[k] != -1)
+        {
+            guesses[pending[k]] = guesses[pending[same[k]]];
+            continue;
+        }
+        else
+        {
+            guesses[pending[k]] = batch[set++];
+        }
+        game->num_computed++;
+        game_share_guess(solver, keys[k], guesses[pending[k]]);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        games[i]->last_guess = guesses[i];
+    }
+    free(batch);
+    free(pending);
+    free(sets);
+    free(keys);
+}
+
+/**
+ * Returns 1 if a guess is WORD_LEN lowercase letters and every mark is 0, 1 or 2.
+ */
+static int guess_valid(const char *guess, const int *marks)
+{
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        if (guess[i] < 'a' || guess[i] > 'z' || marks[i] < 0 || marks[i] > 2)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Folds the server's marks for a guess into the game state.
+ * @param game The game state.
+ * @param solver The solver.
+ * @param guess The guessed word.
+ * @param marks The marks for each position.
+ * @return The feedback pattern of the marks, or -1 if the guess is not WORD_LEN
+ *         lowercase letters or a mark is not 0, 1 or 2. The game is unchanged then.
+ */
+int game_observe(GameState *game, const Solver *solver, const char *guess, const int *marks)
+{
+    if (!guess_valid(guess, marks))
+    {
+        return -1;
+    }
+    int pattern = pattern_from_marks(marks);
+
+    // Stay in the book only while the guesses are the book's
+    if (game->book_node >= 0)
+    {
+        const DictWord *book_guess = &solver->dict.words[solver->book.nodes[game->book_node].guess];
+        if (strncmp(book_guess->text, guess, WORD_LEN) == 0)
+        {
+            game->book_node = book_child(&solver->book, game->book_node, pattern);
+        }
+        else
+        {
+            game->book_node = -1;
+        }
+    }
+
+    constraint_apply(&game->constraint, guess, marks);
+    candidates_narrow(&game->candidates, &solver->dict, &game->constraint);
+    game->num_guesses++;
+    if (game->strategy_ops != NULL && game->strategy_ops->observe != NULL)
+    {
+        // The guess is almost always the one this game picked last, so skip looking it up
+        int index = game->last_guess >= 0 && strncmp(solver->dict.words[game->last_guess].text, guess, WORD_LEN) == 0
+                        ? game->last_guess
+                        : dict_find(&solver->dict, guess);
+        game->strategy_ops->observe(game->strategy_state, solver, index, pattern, &game->candidates);
+    }
+    return pattern;
+}
+
+/**
+ * Rebuilds a game state from the full list of guesses and marks, as carried by
+ * every server response, so any thread or process can take a game over with
+ * nothing but the last response.
+ *
+ * The constraint state is the same whatever the order of the guesses, so all
+ * of them are folded in first and the survivors are narrowed once, in a single
+ * pass over the letter index, instead of once per guess.
+ * @param game The game state to initialize.
+ * @param solver The solver holding the dictionary and opening book.
+ * @param history The guesses of the game so far, in the order they were made.
+ * @param count The number of guesses.
+ * @return 0 on success, -1 if a guess is not WORD_LEN lowercase letters, a
+ *         mark is not 0, 1 or 2, or the survivors cannot be allocated. The game
+ *         is initialized in either case.
+ *
+ * Note: The caller must release the game state with game_free(). The strategy
+ * sets up its state from the rebuilt survivors at its first decision.
+ */
+int game_rebuild(GameState *game, const Solver *solver, const GuessRecord *history, int count)
+{
+    if (game_init(game, solver) == -1)
+    {
+        return -1;
+    }
+    for (int g = 0; g < count; g++)
+    {
+        const GuessRecord *record = &history[g];
+        if (!guess_valid(record->word, record->marks))
+        {
+            return -1;
+        }
+
+        // Follow the book while the guesses are the book's
+        if (game->book_node >= 0)
+        {
+            const DictWord *book_guess = &solver->dict.words[solver->book.nodes[game->book_node].guess];
+            game->book_node = strncmp(book_guess->text, record->word, WORD_LEN) == 0
+                                  ? book_child(&solver->book, game->book_node, pattern_from_marks(record->marks))
+                                  : -1;
+        }
+        constraint_apply(&game->constraint, record->word, record->marks);
+        game->num_guesses++;
+    }
+    if (count > 0)
+    {
+        candidates_narrow(&game->candidates, &solver->dict, &game->constraint);
+    }
+    return 0;
+}
+
+/**
+ * Replaces a game in play with one rebuilt from the full list of guesses and
+ * marks, for when the server's record is not the game played so far (a guess
+ * was lost, repeated or made by another client).
+ * The time budget, cancel flag, timing and counters carry over.
+ * @param game The game state to replace.
+ * @param solver The solver holding the dictionary and opening book.
+ * @param history The guesses of the game so far, in the order they were made.
+ * @param count The number of guesses.
+ * @return 0 on success, -1 if the history is invalid or out of memory (see
+ *         game_rebuild()). The game is left unchanged on failure.
+ */
+int game_resync(GameState *game, const Solver *solver, const GuessRecord *history, int count)
+{
+    GameState rebuilt;
+    if (game_rebuild(&rebuilt, solver, history, count) == -1)
+    {
+        game_free(&rebuilt);
+        return -1;
+    }
+    rebuilt.budget_us = game->budget_us;
+    rebuilt.budget_hits = game->budget_hits;
+    rebuilt.cancel = game->cancel;
+    rebuilt.num_computed = game->num_computed;
+    rebuilt.rtt_ns = game->rtt_ns;
+    rebuilt.speed = game->speed;
+    rebuilt.cheap_picks = game->cheap_picks;
+    game_free(game);
+    *game = rebuilt;
+    return 0;
+}
+
+/**
+ * Copies a game state, so it can be played on without changing the original.
+ * @param dest The game state to initialize.
+ * @param src The game state to copy.
+ * @param solver The solver the game is played with.
+ * @return 0 on success, -1 if the copy cannot be allocated.
+ *
+ * Note: The caller must release the copy with game_free(). The strategy's
+ * state is not copied; the copy sets up its own at its first decision.
+ */
+int game_copy(GameState *dest, const GameState *src, const Solver *solver)
+{
+    *dest = *src;
+    dest->strategy_ops = NULL;
+    dest->strategy_state = NULL;
+    int num_words = solver->dict.num_words;
+    dest->candidates.index = (int *)malloc((num_words > 0 ? num_words : 1) * sizeof(int));
+    dest->candidates.bits = NULL;
+    if (dest->candidates.index == NULL)
+    {
+        return -1;
+    }
+    memcpy(dest->candidates.index, src->candidates.index, src->candidates.count * sizeof(int));
+    if (src->candidates.bits != NULL)
+    {
+        dest->candidates.bits = bitset_alloc(solver->dict.index.num_blocks);
+        if (dest->candidates.bits == NULL)
+        {
+            free(dest->candidates.index);
+            dest->candidates.index = NULL;
+            return -1;
+        }
+        memcpy(dest->candidates.bits, src->candidates.bits, solver->dict.index.num_blocks * sizeof(uint64_t));
+    }
+    return 0;
+}
+
+/**
+ * Releases the memory held by a game state.
+ * @param game The game state to free.
+ */
+void game_free(GameState *game)
+{
+    game_release_strategy(game);
+    candidates_free(&game->candidates);
+}
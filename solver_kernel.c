@@ -0,0 +1,245 @@
+/**
+ * Feedback Kernels for the 3700.network Project - Client Word Solver
+ *
+ * This file computes the feedback patterns of one guess against a packed block
+ * of answers. The answers are stored position-major (all first letters, then
+ * all second letters, ...), so the SIMD kernels compare one guess letter with
+ * 16 (SSE2) or 32 (AVX2) answers per instruction.
+ *
+ * Repeated letters are handled without branches. With G[k] the green mask of
+ * position k, guess position i (letter c, not green) is yellow exactly when
+ *
+ *     #{k : answer[k] == c and not G[k]} > #{i' < i : guess[i'] == c and not G[i']}
+ *
+ * which is the server's left-to-right rule: earlier non-green copies of c in
+ * the guess consume the unmatched copies of c in the answer first.
+ *
+ * feedback_block_scalar() is the reference; it calls feedback_pattern() per
+ * answer. feedback_block() dispatches to the fastest kernel the CPU supports.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <string.h>
+
+// The SIMD kernels add up a pattern in an 8-bit lane, so longer words use the reference kernel
+#if defined(__x86_64__) && defined(__GNUC__) && NUM_PATTERNS <= 256
+#define FEEDBACK_X86 1
+#include <immintrin.h>
+#endif
+
+#define PAD_CODE 31 // Letter code of padding lanes, never equal to a real letter
+
+/**
+ * Packs answers into a position-major block.
+ * @param block The block to fill in.
+ * @param dict The loaded dictionary.
+ * @param index Dictionary indexes of the answers, or NULL for the whole dictionary.
+ * @param count Number of answers.
+ * @return 0 on success, -1 if the block cannot be allocated. The block is left
+ *         empty then, and freeing it is harmless.
+ *
+ * Note: The caller must release the block with answer_block_free().
+ */
+int answer_block_init(AnswerBlock *block, const Dictionary *dict, const int *index, int count)
+{
+    block->count = count;
+    block->padded = (count + FEEDBACK_LANES - 1) / FEEDBACK_LANES * FEEDBACK_LANES;
+    if (block->padded == 0)
+    {
+        block->padded = FEEDBACK_LANES;
+    }
+    memset(block->codes, 0, sizeof(block->codes));
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        if (posix_memalign((void **)&block->codes[i], 32, block->padded) != 0)
+        {
+            block->codes[i] = NULL;
+            answer_block_free(block);
+            return -1;
+        }
+        memset(block->codes[i], PAD_CODE, block->padded);
+        for (int k = 0; k < count; k++)
+        {
+            block->codes[i][k] = dict->words[index != NULL ? index[k] : k].codes[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * Releases the memory held by an answer block.
+ * @param block The block to free.
+ */
+void answer_block_free(AnswerBlock *block)
+{
+    for (int i = 0; i < WORD_LEN; i++)
+    {
+        free(block->codes[i]);
+        block->codes[i] = NULL;
+    }
+    block->count = 0;
+    block->padded = 0;
+}
+
+/**
+ * Reference kernel: one feedback_pattern() call per answer.
+ * @param guess The guessed word.
+ * @param answers The packed answers.
+ * @param patterns Receives one pattern per answer (block->padded entries).
+ */
+void feedback_block_scalar(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns)
+{
+    for (int k = 0; k < answers->count; k++)
+    {
+        DictWord answer;
+        answer.mask = 0;
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            answer.codes[i] = answers->codes[i][k];
+            answer.mask |= LETTER_BIT(answer.codes[i]);
+        }
+        patterns[k] = (Pattern)feedback_pattern(guess, &answer);
+    }
+    memset(patterns + answers->count, 0, (answers->padded - answers->count) * sizeof(Pattern));
+}
+
+#ifdef FEEDBACK_X86
+
+static const int POW3[5] = {1, 3, 9, 27, 81};
+
+/**
+ * SSE2 kernel: 16 answers per step. SSE2 is part of x86-64, so every CPU runs it.
+ */
+static void feedback_block_sse2(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns)
+{
+    for (int k = 0; k < answers->padded; k += 16)
+    {
+        __m128i letters[WORD_LEN];
+        __m128i green[WORD_LEN];
+        __m128i pattern = _mm_setzero_si128();
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            letters[i] = _mm_load_si128((const __m128i *)(answers->codes[i] + k));
+            green[i] = _mm_cmpeq_epi8(letters[i], _mm_set1_epi8((char)guess->codes[i]));
+            pattern = _mm_add_epi8(pattern, _mm_and_si128(green[i], _mm_set1_epi8((char)(2 * POW3[i]))));
+        }
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            __m128i letter = _mm_set1_epi8((char)guess->codes[i]);
+            __m128i unmatched = _mm_setzero_si128(); // Answer copies of the letter not used by a green
+            for (int k2 = 0; k2 < WORD_LEN; k2++)
+            {
+                unmatched = _mm_sub_epi8(unmatched, _mm_andnot_si128(green[k2], _mm_cmpeq_epi8(letters[k2], letter)));
+            }
+            __m128i earlier = _mm_setzero_si128(); // Earlier non-green copies in the guess
+            for (int j = 0; j < i; j++)
+            {
+                if (guess->codes[j] == guess->codes[i])
+                {
+                    earlier = _mm_sub_epi8(earlier, _mm_andnot_si128(green[j], _mm_set1_epi8(-1)));
+                }
+            }
+            __m128i yellow = _mm_andnot_si128(green[i], _mm_cmpgt_epi8(unmatched, earlier));
+            pattern = _mm_add_epi8(pattern, _mm_and_si128(yellow, _mm_set1_epi8((char)POW3[i])));
+        }
+        _mm_store_si128((__m128i *)(patterns + k), pattern);
+    }
+}
+
+/**
+ * AVX2 kernel: 32 answers per step.
+ */
+__attribute__((target("avx2"))) static void feedback_block_avx2(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns)
+{
+    for (int k = 0; k < answers->padded; k += 32)
+    {
+        __m256i letters[WORD_LEN];
+        __m256i green[WORD_LEN];
+        __m256i pattern = _mm256_setzero_si256();
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            letters[i] = _mm256_load_si256((const __m256i *)(answers->codes[i] + k));
+            green[i] = _mm256_cmpeq_epi8(letters[i], _mm256_set1_epi8((char)guess->codes[i]));
+            pattern = _mm256_add_epi8(pattern, _mm256_and_si256(green[i], _mm256_set1_epi8((char)(2 * POW3[i]))));
+        }
+        for (int i = 0; i < WORD_LEN; i++)
+        {
+            __m256i letter = _mm256_set1_epi8((char)guess->codes[i]);
+            __m256i unmatched = _mm256_setzero_si256(); // Answer copies of the letter not used by a green
+            for (int k2 = 0; k2 < WORD_LEN; k2++)
+            {
+                unmatched = _mm256_sub_epi8(unmatched, _mm256_andnot_si256(green[k2], _mm256_cmpeq_epi8(letters[k2], letter)));
+            }
+            __m256i earlier = _mm256_setzero_si256(); // Earlier non-green copies in the guess
+            for (int j = 0; j < i; j++)
+            {
+                if (guess->codes[j] == guess->codes[i])
+                {
+                    earlier = _mm256_sub_epi8(earlier, _mm256_andnot_si256(green[j], _mm256_set1_epi8(-1)));
+                }
+            }
+            __m256i yellow = _mm256_andnot_si256(green[i], _mm256_cmpgt_epi8(unmatched, earlier));
+            pattern = _mm256_add_epi8(pattern, _mm256_and_si256(yellow, _mm256_set1_epi8((char)POW3[i])));
+        }
+        _mm256_store_si256((__m256i *)(patterns + k), pattern);
+    }
+}
+
+#endif // FEEDBACK_X86
+
+/**
+ * Lists the kernels this CPU can run, reference kernel first.
+ * @param kernels Receives up to max kernels.
+ * @param max Size of the kernels array.
+ * @return The number of kernels stored.
+ */
+int feedback_kernels(FeedbackKernel *kernels, int max)
+{
+    int count = 0;
+    if (count < max)
+    {
+        kernels[count++] = (FeedbackKernel){"scalar", feedback_block_scalar};
+    }
+#ifdef FEEDBACK_X86
+    __builtin_cpu_init();
+    if (count < max)
+    {
+        kernels[count++] = (FeedbackKernel){"sse2", feedback_block_sse2};
+    }
+    if (count < max && __builtin_cpu_supports("avx2"))
+    {
+        kernels[count++] = (FeedbackKernel){"avx2", feedback_block_avx2};
+    }
+#endif
+    return count;
+}
+
+/**
+ * Returns the fastest kernel this CPU can run.
+ */
+FeedbackKernel feedback_best_kernel(void)
+{
+    FeedbackKernel kernels[FEEDBACK_MAX_KERNELS];
+    int count = feedback_kernels(kernels, FEEDBACK_MAX_KERNELS);
+    return kernels[count - 1];
+}
+
+/**
+ * Computes the feedback patterns of a guess against a block of answers with the fastest kernel.
+ * @param guess The guessed word.
+ * @param answers The packed answers.
+ * @param patterns Receives one pattern per answer; must hold answers->padded entries.
+ */
+void feedback_block(const DictWord *guess, const AnswerBlock *answers, Pattern *patterns)
+{
+    static FeedbackBlockFunction best = NULL;
+    FeedbackBlockFunction run = __atomic_load_n(&best, __ATOMIC_RELAXED);
+    if (run == NULL)
+    {
+        // Every thread resolves the same function
+        run = feedback_best_kernel().run;
+        __atomic_store_n(&best, run, __ATOMIC_RELAXED);
+    }
+    run(guess, answers, patterns);
+}
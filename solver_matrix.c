@@ -0,0 +1,145 @@
+/**
+ * Pattern Matrix Functions for the 3700.network Project - Client Word Solver
+ *
+ * This file writes and maps the precomputed guess x answer feedback pattern
+ * matrix. The matrix holds one Pattern per pair (the base-3 pattern code, a
+ * single byte for words of up to five letters) and is stored in a versioned file
+ * tied to the word list by its checksum. The client maps the file read-only,
+ * so every client process shares one page-cache copy and a lookup is a single
+ * load instead of a feedback computation.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Fills in the header describing a dictionary.
+ */
+static void matrix_header(PatternFileHeader *header, const Dictionary *dict)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, PATTERN_FILE_MAGIC, sizeof(header->magic));
+    header->version = PATTERN_FILE_VERSION;
+    header->word_len = WORD_LEN;
+    header->num_words = (uint32_t)dict->num_words;
+    header->dict_checksum = dict_checksum(dict);
+}
+
+/**
+ * Computes the full pattern matrix of a dictionary and writes it to a file.
+ * @param dict The loaded dictionary.
+ * @param path Path of the file to write.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int matrix_write(const Dictionary *dict, const char *path)
+{
+    // One row (guess) at a time, computed by the SIMD kernel against every answer
+    AnswerBlock answers;
+    if (answer_block_init(&answers, dict, NULL, dict->num_words) == -1)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+    Pattern *row = (Pattern *)aligned_alloc(32, answers.padded * sizeof(Pattern));
+    if (row == NULL)
+    {
+        answer_block_free(&answers);
+        return -1;
+    }
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        free(row);
+        answer_block_free(&answers);
+        return -1;
+    }
+
+    PatternFileHeader header;
+    matrix_header(&header, dict);
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 ? 0 : -1;
+    for (int g = 0; g < dict->num_words && result == 0; g++)
+    {
+        feedback_block(&dict->words[g], &answers, row);
+        if (fwrite(row, sizeof(Pattern), dict->num_words, file) != (size_t)dict->num_words)
+        {
+            result = -1;
+        }
+    }
+    free(row);
+    answer_block_free(&answers);
+
+    if (fclose(file) != 0)
+    {
+        result = -1;
+    }
+    return result;
+}
+
+/**
+ * Maps a pattern matrix file read-only.
+ * @param matrix The matrix to fill in. Its data is NULL if the file cannot be used.
+ * @param dict The loaded dictionary the matrix must match.
+ * @param path Path of the pattern matrix file.
+ * @return 0 on success, -1 if the file is missing or does not match the dictionary.
+ */
+int matrix_open(PatternMatrix *matrix, const Dictionary *dict, const char *path)
+{
+    memset(matrix, 0, sizeof(*matrix));
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1)
+    {
+        return -1;
+    }
+
+    struct stat info;
+    size_t expected = sizeof(PatternFileHeader) + (size_t)dict->num_words * dict->num_words * sizeof(Pattern);
+    if (fstat(fd, &info) == -1 || (size_t)info.st_size != expected)
+    {
+        fprintf(stderr, "Ignoring %s: size does not match the word list\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, expected, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid
+    if (map == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    PatternFileHeader header;
+    matrix_header(&header, dict);
+    if (memcmp(map, &header, sizeof(header)) != 0)
+    {
+        fprintf(stderr, "Ignoring %s: built for another version or word list\n", path);
+        munmap(map, expected);
+        return -1;
+    }
+
+    matrix->map = map;
+    matrix->map_size = expected;
+    matrix->data = (const Pattern *)((const char *)map + sizeof(PatternFileHeader));
+    matrix->num_words = dict->num_words;
+    return 0;
+}
+
+/**
+ * Unmaps a pattern matrix.
+ * @param matrix The matrix to release.
+ */
+void matrix_close(PatternMatrix *matrix)
+{
+    if (matrix->map != NULL)
+    {
+        munmap(matrix->map, matrix->map_size);
+    }
+    memset(matrix, 0, sizeof(*matrix));
+}
@@ -0,0 +1,205 @@
+/**
+ * Worker Pool for the 3700.network Project - Client Word Solver
+ *
+ * This file implements a fixed pool of pthreads that is created once per
+ * process and reused for every decision. A task is run by all workers at the
+ * same time; each worker receives its own id and a private, cache-line
+ * aligned scratch area (its feedback histogram), so sharding a loop over the
+ * workers needs no locking in the hot path. The calling thread acts as
+ * worker 0, so a pool of N workers only starts N - 1 threads.
+ */
+
+#include "solver.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct WorkerPool
+{
+    int num_workers;        // Including the calling thread
+    pthread_t *threads;     // num_workers - 1 background threads
+    WorkerScratch *scratch; // One per worker
+
+    pthread_mutex_t lock;
+    pthread_cond_t start; // Signalled when a new task is posted
+    pthread_cond_t done;  // Signalled when the last worker finishes
+    unsigned generation;  // Incremented for every posted task
+    int pending;          // Background workers still running the current task
+    int shutdown;
+
+    PoolTask task;
+    void *arg;
+};
+
+typedef struct
+{
+    WorkerPool *pool;
+    int id;
+} WorkerStart;
+
+/**
+ * Main loop of a background worker: waits for a task, runs its share, reports back.
+ */
+static void *worker_main(void *start_arg)
+{
+    WorkerStart start = *(WorkerStart *)start_arg;
+    free(start_arg);
+    WorkerPool *pool = start.pool;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1)
+    {
+        while (pool->generation == seen && !pool->shutdown)
+        {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->shutdown)
+        {
+            break;
+        }
+        seen = pool->generation;
+        PoolTask task = pool->task;
+        void *arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(arg, start.id, pool->num_workers, &pool->scratch[start.id]);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Creates a worker pool.
+ * @param num_workers Number of workers including the calling thread, or 0 for one per online core.
+ * @return The pool, or NULL if no thread could be started.
+ *
+ * Note: The caller must release the pool with pool_destroy().
+ */
+WorkerPool *pool_create(int num_workers)
+{
+    if (num_workers <= 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cores > 0 ? (int)cores : 1;
+    }
+
+    WorkerPool *pool = (WorkerPool *)calloc(1, sizeof(WorkerPool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    pool->num_workers = num_workers;
+    pool->threads = (pthread_t *)calloc(num_workers, sizeof(pthread_t));
+    if (pool->threads == NULL || posix_memalign((void **)&pool->scratch, 64, num_workers * sizeof(WorkerScratch)) != 0)
+    {
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (int i = 1; i < num_workers; i++)
+    {
+        WorkerStart *start = (WorkerStart *)malloc(sizeof(WorkerStart));
+        if (start != NULL)
+        {
+            start->pool = pool;
+            start->id = i;
+        }
+        if (start == NULL || pthread_create(&pool->threads[i - 1], NULL, worker_main, start) != 0)
+        {
+            // Run with the workers that did start
+            free(start);
+            pool->num_workers = i;
+            break;
+        }
+    }
+    if (pool->num_workers == 1 && num_workers > 1)
+    {
+        // No worker started, so the caller scores on its own thread without a pool
+        pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * Runs a task on every worker and waits until all of them are done.
+ * @param pool The worker pool.
+ * @param task The task; it is called once per worker with that worker's id and scratch area.
+ * @param arg The argument passed to every call of the task.
+ */
+void pool_run(WorkerPool *pool, PoolTask task, void *arg)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->pending = pool->num_workers - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    // The calling thread is worker 0
+    task(arg, 0, pool->num_workers, &pool->scratch[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Returns the number of workers in a pool, including the calling thread.
+ */
+int pool_size(const WorkerPool *pool)
+{
+    return pool->num_workers;
+}
+
+/**
+ * Returns the scratch areas of all workers, indexed by worker id.
+ * They hold each worker's results after pool_run() returns.
+ */
+WorkerScratch *pool_scratch(WorkerPool *pool)
+{
+    return pool->scratch;
+}
+
+/**
+ * Stops all workers and releases the pool.
+ * @param pool The worker pool, may be NULL.
+ */
+void pool_destroy(WorkerPool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->num_workers; i++)
+    {
+        pthread_join(pool->threads[i - 1], NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    free(pool->scratch);
+    free(pool->threads);
+    free(pool);
+}
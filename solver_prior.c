@@ -0,0 +1,127 @@
+/**
+ * Answer Prior Functions for the 3700.network Project - Client Word Solver
+ *
+ * The server does not draw its secrets uniformly from word_list.txt. This file
+ * records every solved secret in a history file (one word per line, like the
+ * word list) and turns the history into a prior: word w gets the weight
+ *
+ *     weight(w) = solved(w) + PRIOR_SMOOTHING
+ *
+ * where solved(w) is the number of times w was the secret. The smoothing keeps
+ * every word possible and makes a short history only a gentle nudge. The
+ * entropy strategy weighs each surviving answer by its prior weight
+ * (solver_entropy.c), so guesses that split the likely answers are preferred.
+ *
+ * The client appends to HISTORY_FILE after every game, but builds its prior
+ * from PRIOR_FILE, a snapshot that make book refreshes. A prior that changed
+ * with every game would change its checksum too, and the opening book and
+ * cached decisions, which only apply under the prior they were made with,
+ * would stop matching after the first recorded game.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Appends a solved secret to the history file.
+ * @param path Path of the history file, created if it is missing.
+ * @param word The secret word.
+ * @return 0 on success, -1 on failure (errno is set).
+ *
+ * Note: Each word is one write() on a file opened with O_APPEND, so concurrent
+ * clients never interleave their lines.
+ */
+int history_record(const char *path, const char *word)
+{
+    char line[WORD_LEN + 2];
+    int len = snprintf(line, sizeof(line), "%.*s\n", WORD_LEN, word);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    int result = write(fd, line, len) == len ? 0 : -1;
+    close(fd);
+    return result;
+}
+
+/**
+ * Builds the prior from a history file.
+ * @param prior The prior to initialize.
+ * @param dict The dictionary the prior weighs.
+ * @param path Path of the history file.
+ * @return The number of solved games read, or -1 if the file cannot be read (errno is set).
+ *
+ * Note: Words are looked up through the letter index (dict_find()), so each
+ * line costs a few bitset reads rather than a pass over the dictionary. Words
+ * that are not in the dictionary are skipped. With no usable history the prior
+ * stays empty and every answer is equally likely. The caller must release the
+ * prior with prior_free().
+ */
+int prior_load(AnswerPrior *prior, const Dictionary *dict, const char *path)
+{
+    memset(prior, 0, sizeof(*prior));
+
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    int *solved = (int *)calloc(dict->num_words > 0 ? dict->num_words : 1, sizeof(int));
+    if (solved == NULL)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    char line[64];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        int w = dict_find(dict, line);
+        if (w != -1)
+        {
+            solved[w]++;
+            prior->num_games++;
+        }
+    }
+    fclose(file);
+
+    if (prior->num_games > 0)
+    {
+        prior->weights = (double *)malloc(dict->num_words * sizeof(double));
+        if (prior->weights != NULL)
+        {
+            // Ties the decisions made with this prior to it
+            uint32_t hash = 2166136261u;
+            for (int w = 0; w < dict->num_words; w++)
+            {
+                prior->weights[w] = solved[w] + PRIOR_SMOOTHING;
+                hash = (hash ^ (uint32_t)solved[w]) * 16777619u;
+            }
+            prior->checksum = hash != 0 ? hash : 1;
+        }
+        else
+        {
+            prior->num_games = 0;
+        }
+    }
+    free(solved);
+    return prior->num_games;
+}
+
+/**
+ * Releases the memory held by a prior.
+ * @param prior The prior to free.
+ */
+void prior_free(AnswerPrior *prior)
+{
+    free(prior->weights);
+    memset(prior, 0, sizeof(*prior));
+}
@@ -0,0 +1,180 @@
+/**
+ * Speculative Decisions for the 3700.network Project - Client Word Solver
+ *
+ * While a guess is on its way to the server, the client has nothing to do but
+ * wait for the response. This file uses that time: a background thread plays
+ * the game on for the most likely feedback patterns of the guess, most likely
+ * first, and makes the next decision for each of them. The decisions land in
+ * the decision table like any other, so when the response arrives the client's
+ * own decision is usually a table lookup.
+ *
+ * When the response arrives, the speculation stops. The decision in progress
+ * is finished if it is the one the response asks for, and abandoned through
+ * the deadline's cancel flag otherwise; an abandoned decision is not stored.
+ * The thread uses the solver's worker pool only while the client is waiting,
+ * so the two never run a task on the pool at the same time.
+ */
+
+#include "solver.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct Speculation
+{
+    const Solver *solver;
+    const GameState *game; // The game before the response, left untouched until the speculation finishes
+    Strategy strategy;
+    int guess;
+
+    int patterns[NUM_PATTERNS]; // The patterns to decide for, most likely first
+    int num_patterns;
+    uint8_t decided[NUM_PATTERNS]; // 1 once the decision for a pattern is in the table
+
+    int current; // The pattern being decided, -1 when none
+    int stop;    // Set when the response has arrived
+    int cancel;  // Abandons the decision in progress
+    pthread_t thread;
+};
+
+/**
+ * Background thread: decides for each pattern in turn until stopped.
+ */
+static void *speculate(void *arg)
+{
+    Speculation *spec = (Speculation *)arg;
+    const DictWord *word = &spec->solver->dict.words[spec->guess];
+    for (int i = 0; i < spec->num_patterns; i++)
+    {
+        // Publish the pattern before looking at the stop flag, so the client knows what it would abandon
+        int pattern = spec->patterns[i];
+        __atomic_store_n(&spec->current, pattern, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&spec->stop, __ATOMIC_SEQ_CST))
+        {
+            break;
+        }
+
+        GameState next;
+        if (game_copy(&next, spec->game, spec->solver) == -1)
+        {
+            break;
+        }
+        int marks[WORD_LEN];
+        pattern_to_marks(pattern, marks);
+        game_observe(&next, spec->solver, word->text, marks);
+        if (game_in_book(&next, spec->solver, spec->strategy))
+        {
+            // The book answers right away
+            game_free(&next);
+            continue;
+        }
+        next.cancel = &spec->cancel;
+        next.budget_hits = 0;
+        if (game_next_guess(&next, spec->solver, spec->strategy) != -1 && next.budget_hits == 0)
+        {
+            spec->decided[pattern] = 1;
+        }
+        game_free(&next);
+    }
+    __atomic_store_n(&spec->current, -1, __ATOMIC_SEQ_CST);
+    return NULL;
+}
+
+/**
+ * Starts deciding the next guess for the likely responses to a guess, in the background.
+ * @param solver The solver, whose decision table receives the decisions.
+ * @param game The game the guess was made in. It must not change until speculation_finish().
+ * @param strategy The strategy the game is played with.
+ * @param guess Dictionary index of the guess sent.
+ * @return The running speculation, or NULL if there is nothing worth deciding ahead
+ *         or no thread could be started.
+ *
+ * Note: Patterns that leave two survivors or fewer, or stay in the opening
+ * book, are skipped, since deciding them costs nothing. Strategies whose
+ * decisions cannot be shared through the table are not speculated for.
+ */
+Speculation *speculation_start(const Solver *solver, const GameState *game, Strategy strategy, int guess)
+{
+    if (solver->table == NULL || !(strategy_ops(strategy)->flags & STRATEGY_SHARED) || game->candidates.count <= 2)
+    {
+        return NULL;
+    }
+
+    // Weigh each pattern by the answers that produce it
+    double mass[NUM_PATTERNS] = {0};
+    int sizes[NUM_PATTERNS] = {0};
+    const double *weights = solver->prior.weights;
+    for (int i = 0; i < game->candidates.count; i++)
+    {
+        int answer = game->candidates.index[i];
+        int pattern = solver_pattern(solver, guess, answer);
+        mass[pattern] += weights != NULL ? weights[answer] : 1.0;
+        sizes[pattern]++;
+    }
+
+    Speculation *spec = (Speculation *)calloc(1, sizeof(Speculation));
+    if (spec == NULL)
+    {
+        return NULL;
+    }
+    for (int p = 0; p < PATTERN_SOLVED; p++)
+    {
+        if (sizes[p] <= 2)
+        {
+            continue;
+        }
+        // Insertion sort: likelier first, then the lower pattern
+        int i = spec->num_patterns++;
+        while (i > 0 && mass[spec->patterns[i - 1]] < mass[p])
+        {
+            spec->patterns[i] = spec->patterns[i - 1];
+            i--;
+        }
+        spec->patterns[i] = p;
+    }
+    if (spec->num_patterns == 0)
+    {
+        free(spec);
+        return NULL;
+    }
+
+    spec->solver = solver;
+    spec->game = game;
+    // The timed strategy takes every entropy decision it finds in the table, so decide those
+    spec->strategy = strategy == STRATEGY_TIMED ? STRATEGY_ENTROPY : strategy;
+    spec->guess = guess;
+    spec->current = -1;
+    if (pthread_create(&spec->thread, NULL, speculate, spec) != 0)
+    {
+        free(spec);
+        return NULL;
+    }
+    return spec;
+}
+
+/**
+ * Stops a speculation once the response has arrived, and releases it.
+ * @param spec The speculation (may be NULL).
+ * @param pattern The feedback pattern received, or -1 if the game is over.
+ * @return 1 if the decision for the pattern was made ahead, 0 otherwise.
+ *
+ * Note: If the decision for the pattern is in progress, it is finished first,
+ * so the client finds it in the decision table.
+ */
+int speculation_finish(Speculation *spec, int pattern)
+{
+    if (spec == NULL)
+    {
+        return 0;
+    }
+    __atomic_store_n(&spec->stop, 1, __ATOMIC_SEQ_CST);
+    if (pattern == -1 || __atomic_load_n(&spec->current, __ATOMIC_SEQ_CST) != pattern)
+    {
+        __atomic_store_n(&spec->cancel, 1, __ATOMIC_SEQ_CST);
+    }
+    pthread_join(spec->thread, NULL);
+
+    int decided = pattern >= 0 && pattern < NUM_PATTERNS && spec->decided[pattern];
+    free(spec);
+    return decided;
+}
@@ -0,0 +1,198 @@
+/**
+ * Guess Strategies for the 3700.network Project - Client Word Solver
+ *
+ * Every strategy implements the StrategyOps interface (solver.h). This file
+ * registers the built-in ones, loads more from shared objects, and maps
+ * strategy names to them:
+ *
+ * - "first":     The first surviving word in word list order.
+ * - "entropy":   The dictionary word with the highest expected information (solver_entropy.c).
+ *                Once few candidates survive, the exact endgame search takes over (solver_endgame.c).
+ * - "timed":     The entropy strategy's guess where scoring saves more wall time
+ *                than it costs, and the first survivor elsewhere (solver_timing.c).
+ *                Without the round trip, which only the game knows, it plays like "entropy".
+ * - "frequency": The survivor whose letters are the most common at their positions
+ *                among the survivors, with the letter counts kept up to date as
+ *                words are eliminated (solver_frequency.c).
+ *
+ * A strategy shared object exports a StrategyOps named STRATEGY_SYMBOL, built
+ * against the same STRATEGY_ABI_VERSION. It is selected with a path instead of
+ * a name, so a new strategy can be tried without rebuilding the client.
+ */
+
+#include "solver.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+
+static int first_fit_next_guess(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    (void)state;
+    (void)solver;
+    (void)deadline;
+    return candidates->count > 0 ? candidates->index[0] : -1;
+}
+
+static int entropy_next_guess(void *state, const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    (void)state;
+    if (candidates->count == 0)
+    {
+        return -1;
+    }
+#ifdef ENTROPY_OPENER
+    if (candidates->count == solver->dict.num_words && solver->prior.weights == NULL)
+    {
+        // Nothing is known yet, so the answer is always the same and scoring it costs seconds; a prior changes it
+        int opener = dict_find(&solver->dict, ENTROPY_OPENER);
+        if (opener != -1)
+        {
+            return opener;
+        }
+    }
+#endif
+    if (candidates->count <= ENDGAME_MAX_CANDIDATES)
+    {
+        int guess = endgame_best_guess(solver, candidates, solver->endgame_budget_ms, deadline, NULL);
+        if (guess != -1)
+        {
+            return guess;
+        }
+
+        // The search gave up, so the entropy guess depends on how fast this run was and must not be shared
+        guess = entropy_best_guess(solver, candidates, deadline);
+        deadline_expire(deadline);
+        return guess;
+    }
+    return entropy_best_guess(solver, candidates, deadline);
+}
+
+static const StrategyOps FIRST_FIT_OPS = {STRATEGY_ABI_VERSION, STRATEGY_SHARED, "first", NULL, NULL, first_fit_next_guess, NULL};
+static const StrategyOps ENTROPY_OPS = {STRATEGY_ABI_VERSION, STRATEGY_SHARED, "entropy", NULL, NULL, entropy_next_guess, NULL};
+static const StrategyOps TIMED_OPS = {STRATEGY_ABI_VERSION, STRATEGY_SHARED, "timed", NULL, NULL, entropy_next_guess, NULL};
+static const StrategyOps FREQUENCY_OPS = {STRATEGY_ABI_VERSION, STRATEGY_SHARED, "frequency", frequency_init, frequency_observe, frequency_next_guess,
+                                         frequency_destroy};
+
+// Indexed by Strategy; loaded strategies are appended at startup, before any game starts
+static const StrategyOps *strategies[MAX_STRATEGIES] = {&FIRST_FIT_OPS, &ENTROPY_OPS, &TIMED_OPS, &FREQUENCY_OPS};
+static int num_strategies = NUM_STRATEGIES;
+
+/**
+ * Looks up a strategy by its command-line name. A name with a '/' in it is the
+ * path of a strategy shared object, which is loaded.
+ * @param name The strategy name or path.
+ * @param strategy Receives the strategy.
+ * @return 0 on success, -1 if the name is unknown or the shared object cannot be loaded.
+ */
+int strategy_from_name(const char *name, Strategy *strategy)
+{
+    if (strchr(name, '/') != NULL)
+    {
+        return strategy_load(name, strategy);
+    }
+    for (int s = 0; s < num_strategies; s++)
+    {
+        if (strcmp(name, strategies[s]->name) == 0)
+        {
+            *strategy = (Strategy)s;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Loads a strategy from a shared object and registers it.
+ * @param path Path of the shared object, as passed to dlopen().
+ * @param strategy Receives the strategy.
+ * @return 0 on success, -1 if the object cannot be loaded, does not export a
+ *         strategy of this ABI version, or too many strategies are loaded.
+ *
+ * Note: Not thread-safe; strategies are loaded while parsing the command line.
+ * The object stays loaded until the process exits.
+ */
+int strategy_load(const char *path, Strategy *strategy)
+{
+    if (num_strategies == MAX_STRATEGIES)
+    {
+        fprintf(stderr, "Cannot load %s: too many strategies\n", path);
+        return -1;
+    }
+    void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL)
+    {
+        fprintf(stderr, "Cannot load %s: %s\n", path, dlerror());
+        return -1;
+    }
+    const StrategyOps *ops = (const StrategyOps *)dlsym(handle, STRATEGY_SYMBOL);
+    if (ops == NULL || ops->abi_version != STRATEGY_ABI_VERSION || ops->next_guess == NULL || ops->name == NULL)
+    {
+        fprintf(stderr, "Cannot load %s: no %s of version %d\n", path, STRATEGY_SYMBOL, STRATEGY_ABI_VERSION);
+        dlclose(handle);
+        return -1;
+    }
+    strategies[num_strategies] = ops;
+    *strategy = (Strategy)num_strategies++;
+    return 0;
+}
+
+/**
+ * Returns the name of a strategy.
+ */
+const char *strategy_name(Strategy strategy)
+{
+    return strategies[strategy]->name;
+}
+
+/**
+ * Returns the implementation of a strategy.
+ */
+const StrategyOps *strategy_ops(Strategy strategy)
+{
+    return strategies[strategy];
+}
+
+/**
+ * Returns the 32-bit value that ties stored decisions to a strategy. Built-in
+ * strategies use their number, and loaded ones a hash of their name, since
+ * their number depends on the command line.
+ */
+uint64_t strategy_key(Strategy strategy)
+{
+    if (strategy < NUM_STRATEGIES)
+    {
+        return (uint64_t)strategy;
+    }
+    uint32_t hash = 2166136261u;
+    for (const char *c = strategies[strategy]->name; *c != '\0'; c++)
+    {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    return (uint64_t)(hash | 0x80000000u);
+}
+
+/**
+ * Picks the next word to guess, outside of any game: the strategy's per-game
+ * state lives only for this decision.
+ * @param strategy The strategy to use.
+ * @param solver The solver holding the dictionary and pattern matrix.
+ * @param candidates The surviving candidates, in dictionary order.
+ * @param deadline When to settle for the best guess found so far, or NULL for no limit.
+ * @return Dictionary index of the word to guess, or -1 if there are no candidates
+ *         or the strategy cannot be set up.
+ */
+int strategy_next_guess(Strategy strategy, const Solver *solver, const CandidateSet *candidates, Deadline *deadline)
+{
+    const StrategyOps *ops = strategies[strategy];
+    void *state = NULL;
+    if (candidates->count == 0 || (ops->init != NULL && ops->init(&state, solver, candidates) == -1))
+    {
+        return -1;
+    }
+    int guess = ops->next_guess(state, solver, candidates, deadline);
+    if (ops->destroy != NULL)
+    {
+        ops->destroy(state);
+    }
+    return guess;
+}
@@ -0,0 +1,136 @@
+/**
+ * Decision Table for the 3700.network Project - Client Word Solver
+ *
+ * This file implements a fixed-size transposition table of solver decisions,
+ * shared by every game played in the process. Games that reach the same
+ * constraint state (the same guesses and feedback, in any order) need the same
+ * next guess, so the first game to compute it stores it here and the others
+ * look it up instead of scoring the dictionary again.
+ *
+ * The table is lock-free. Each slot holds two 64-bit words, the stored guess
+ * and the key XOR the guess, written and read with separate atomic accesses.
+ * A reader only accepts a slot whose two words agree with the key, so a slot
+ * torn by two concurrent writers reads as a miss, never as a wrong guess. A
+ * full probe window is resolved by overwriting the key's home slot.
+ */
+
+#include "solver.h"
+#include <stdlib.h>
+
+#define TABLE_PROBES 4 // Slots a key may occupy, starting at its home slot
+
+typedef struct
+{
+    uint64_t check; // key ^ data
+    uint64_t data;  // Dictionary index of the guess + 1, 0 for an empty slot
+} TableSlot;
+
+struct DecisionTable
+{
+    TableSlot *slots;
+    uint64_t mask; // Number of slots - 1
+
+    // Usage counters, kept apart so they do not share a cache line with each other
+    uint64_t lookups __attribute__((aligned(64)));
+    uint64_t hits __attribute__((aligned(64)));
+};
+
+/**
+ * Creates an empty decision table.
+ * @param bits The table holds 2^bits decisions.
+ * @return The table, or NULL if it cannot be allocated.
+ *
+ * Note: The caller must release the table with table_destroy().
+ */
+DecisionTable *table_create(int bits)
+{
+    DecisionTable *table = (DecisionTable *)aligned_alloc(64, sizeof(DecisionTable));
+    if (table == NULL)
+    {
+        return NULL;
+    }
+    table->slots = (TableSlot *)calloc((size_t)1 << bits, sizeof(TableSlot));
+    if (table->slots == NULL)
+    {
+        free(table);
+        return NULL;
+    }
+    table->mask = ((uint64_t)1 << bits) - 1;
+    table->lookups = 0;
+    table->hits = 0;
+    return table;
+}
+
+/**
+ * Looks up the decision stored for a key.
+ * @param table The decision table.
+ * @param key The key, usually constraint_hash() of the game state.
+ * @return Dictionary index of the stored guess, or -1 if the key is not in the table.
+ */
+int table_lookup(DecisionTable *table, uint64_t key)
+{
+    __atomic_fetch_add(&table->lookups, 1, __ATOMIC_RELAXED);
+    for (int probe = 0; probe < TABLE_PROBES; probe++)
+    {
+        TableSlot *slot = &table->slots[(key + probe) & table->mask];
+        uint64_t data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+        uint64_t check = __atomic_load_n(&slot->check, __ATOMIC_RELAXED);
+        if (data != 0 && (check ^ data) == key)
+        {
+            __atomic_fetch_add(&table->hits, 1, __ATOMIC_RELAXED);
+            return (int)(data - 1);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Stores the decision for a key, replacing an older decision if the key's slots are full.
+ * @param table The decision table.
+ * @param key The key.
+ * @param guess Dictionary index of the guess.
+ */
+void table_store(DecisionTable *table, uint64_t key, int guess)
+{
+    uint64_t data = (uint64_t)guess + 1;
+    TableSlot *target = &table->slots[key & table->mask];
+    for (int probe = 0; probe < TABLE_PROBES; probe++)
+    {
+        TableSlot *slot = &table->slots[(key + probe) & table->mask];
+        uint64_t slot_data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+        uint64_t slot_check = __atomic_load_n(&slot->check, __ATOMIC_RELAXED);
+        if (slot_data == 0 || (slot_check ^ slot_data) == key)
+        {
+            target = slot;
+            break;
+        }
+    }
+    __atomic_store_n(&target->data, data, __ATOMIC_RELAXED);
+    __atomic_store_n(&target->check, key ^ data, __ATOMIC_RELAXED);
+}
+
+/**
+ * Reports how often the table answered a lookup.
+ * @param table The decision table.
+ * @param lookups Receives the number of lookups.
+ * @param hits Receives the number of lookups that found a decision.
+ */
+void table_stats(const DecisionTable *table, uint64_t *lookups, uint64_t *hits)
+{
+    *lookups = __atomic_load_n(&table->lookups, __ATOMIC_RELAXED);
+    *hits = __atomic_load_n(&table->hits, __ATOMIC_RELAXED);
+}
+
+/**
+ * Releases a decision table.
+ * @param table The table to release (may be NULL).
+ */
+void table_destroy(DecisionTable *table)
+{
+    if (table == NULL)
+    {
+        return;
+    }
+    free(table->slots);
+    free(table);
+}
@@ -0,0 +1,318 @@
+/**
+ * Time Model for the 3700.network Project - Client Word Solver
+ *
+ * The fewest guesses are not always the fastest game: a decision that takes
+ * longer than a round trip to the server costs more than the guess it saves.
+ * This file models both sides, so the timed strategy can pick, at every
+ * decision, whichever of two moves is expected to finish the game sooner:
+ *
+ * - Scoring: the entropy strategy's guess. Finishing from n survivors takes
+ *   G(n) guesses and K(n) of CPU time, this decision included, so
+ *
+ *       T_score = RTT * G(n) + K(n)
+ *
+ * - The cheap move: the first survivor, picked instantly. Its feedback splits
+ *   the survivors into buckets of n_b answers with probability p_b, each then
+ *   finished by scoring, so
+ *
+ *       T_cheap = RTT * (1 + sum_b p_b * G(n_b)) + sum_b p_b * K(n_b)
+ *
+ * G, K and the time of a single decision C(n) are tables by survivor count
+ * (TimingModel). They are measured with ./simulate -g entropy -m -M, which
+ * writes them to TIMING_FILE for the client to read, so they match the host,
+ * the word list and the word length. Without that file, the built-in tables
+ * below are used, with their times scaled by the size of the dictionary,
+ * since a scoring decision scores every dictionary word at most. The round
+ * trip is measured on the live connection, and the times are scaled by how
+ * fast the decisions of the game actually ran on this host compared with C.
+ */
+
+#include "solver.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define TIMING_SMOOTHING 0.25 // Weight of a new measurement in the running estimates
+
+/*
+ * The built-in model, measured with ./simulate -g entropy -m on the 15918
+ * words of word_list.txt (TIMING_REFERENCE_WORDS) with WORD_LEN 5, without a
+ * book or a prior, on a single thread of one host. Other hosts correct
+ * the times through the game's speed estimate. For other word lengths the
+ * guesses are only a rough guide; measure them with ./simulate-N -m -M.
+ */
+
+/**
+ * Guesses needed to finish by scoring, by floor(log2(survivors)).
+ */
+static const double EXPECTED_GUESSES[TIMING_BUCKETS] = {
+    1.00, 1.59, 1.99, 2.21, 2.46, 2.73, 2.96, 3.05, 3.20, 3.31, 3.33, 3.50, 3.80, 4.08,
+};
+
+/**
+ * Time of one scoring decision in microseconds, by floor(log2(survivors)),
+ * measured in the same run. The endgame search makes the decisions over 32 to
+ * 63 survivors the most expensive, and the opener costs nothing since it is
+ * precomputed. Buckets no game reached are interpolated.
+ */
+static const double DECISION_US[TIMING_BUCKETS] = {
+    3, 938, 4709, 7172, 9825, 26568, 4277, 5597, 4442, 3348, 2327, 2500, 2500, 118,
+};
+
+/**
+ * Time of all the scoring decisions left in the game in microseconds, this one
+ * included, by floor(log2(survivors)), measured in the same run.
+ */
+static const double COMPUTE_LEFT_US[TIMING_BUCKETS] = {
+    3, 939, 4831, 7857, 11802, 30118, 10227, 13192, 15710, 15951, 15951, 15951, 15951, 15348,
+};
+
+/**
+ * Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ */
+uint64_t timing_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * Sets up the built-in time model for a dictionary, with its times scaled by
+ * the number of words it has against the word list it was measured on.
+ * @param model The model to fill in.
+ * @param dict The loaded dictionary.
+ */
+void timing_init(TimingModel *model, const Dictionary *dict)
+{
+    double scale = dict->num_words > 0 ? (double)dict->num_words / TIMING_REFERENCE_WORDS : 1.0;
+    for (int b = 0; b < TIMING_BUCKETS; b++)
+    {
+        model->guesses[b] = EXPECTED_GUESSES[b];
+        model->decision_us[b] = DECISION_US[b] * scale;
+        model->compute_left_us[b] = COMPUTE_LEFT_US[b] * scale;
+    }
+    model->measured = 0;
+}
+
+/**
+ * Reads a time model measured by ./simulate -m -M.
+ *
+ * The file is text: a header line "timing <WORD_LEN> <words> <checksum>" for
+ * the dictionary it was measured on, then one line per bucket b of
+ * floor(log2(survivors)): "<b> <guesses> <decision us> <compute left us>".
+ * Lines starting with '#' are comments.
+ * @param model The model to replace. It is left unchanged on failure.
+ * @param dict The loaded dictionary the model must have been measured on.
+ * @param path Path of the file.
+ * @return 0 on success, -1 if the file is missing, malformed or was measured on another dictionary.
+ */
+int timing_load(TimingModel *model, const Dictionary *dict, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    TimingModel loaded;
+    loaded.measured = 1;
+    char line[256];
+    int header = 0;
+    int buckets = 0;
+    int valid = 1;
+    while (valid && fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+        int word_len, num_words, b;
+        unsigned checksum;
+        double guesses, decision_us, compute_left_us;
+        if (!header)
+        {
+            valid = sscanf(line, "timing %d %d %x", &word_len, &num_words, &checksum) == 3 && word_len == WORD_LEN &&
+                    num_words == dict->num_words && checksum == dict->checksum;
+            header = 1;
+        }
+        else if (sscanf(line, "%d %lf %lf %lf", &b, &guesses, &decision_us, &compute_left_us) == 4 && b == buckets &&
+                 b < TIMING_BUCKETS && guesses >= 1.0 && decision_us >= 0.0 && compute_left_us >= decision_us)
+        {
+            loaded.guesses[b] = guesses;
+            loaded.decision_us[b] = decision_us;
+            loaded.compute_left_us[b] = compute_left_us;
+            buckets++;
+        }
+        else
+        {
+            valid = 0;
+        }
+    }
+    fclose(file);
+    if (!valid || buckets != TIMING_BUCKETS)
+    {
+        fprintf(stderr, "Ignoring %s: measured on another word list, or malformed\n", path);
+        return -1;
+    }
+    *model = loaded;
+    return 0;
+}
+
+/**
+ * Writes a time model in the format timing_load() reads.
+ * @param model The model.
+ * @param dict The loaded dictionary it was measured on.
+ * @param path Path of the file to write.
+ * @return 0 on success, -1 on failure (errno is set).
+ */
+int timing_write(const TimingModel *model, const Dictionary *dict, const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    fprintf(file, "# Time model of the timed strategy, by floor(log2(survivors)): guesses, decision us, compute left us\n");
+    fprintf(file, "timing %d %d %08x\n", WORD_LEN, dict->num_words, (unsigned)dict->checksum);
+    for (int b = 0; b < TIMING_BUCKETS; b++)
+    {
+        fprintf(file, "%d %.2f %.0f %.0f\n", b, model->guesses[b], model->decision_us[b], model->compute_left_us[b]);
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+/**
+ * Reads a table by survivor count, interpolating linearly in log2(survivors)
+ * between the bucket means, which sit in the middle of their buckets.
+ */
+static double table_lookup_log2(const double *table, int survivors)
+{
+    double x = log2((double)survivors) - 0.5;
+    if (x <= 0.0)
+    {
+        return table[0];
+    }
+    if (x >= TIMING_BUCKETS - 1)
+    {
+        return table[TIMING_BUCKETS - 1];
+    }
+    int b = (int)x;
+    return table[b] + (x - b) * (table[b + 1] - table[b]);
+}
+
+/**
+ * Estimates the guesses needed to finish a game by scoring, this guess included.
+ * @param model The time model.
+ * @param survivors The number of surviving candidates.
+ * @return The expected number of guesses.
+ */
+double timing_expected_guesses(const TimingModel *model, int survivors)
+{
+    if (survivors <= 2)
+    {
+        // Guess one, then the other if needed
+        return survivors <= 1 ? survivors : 1.5;
+    }
+    return table_lookup_log2(model->guesses, survivors);
+}
+
+/**
+ * Estimates the time of the scoring decisions needed to finish a game on the
+ * host the model was measured on, this decision included.
+ * @param model The time model.
+ * @param survivors The number of surviving candidates.
+ * @return The expected time in nanoseconds.
+ */
+double timing_expected_compute_ns(const TimingModel *model, int survivors)
+{
+    if (survivors <= 2)
+    {
+        return 0.0; // Nothing left to score
+    }
+    return table_lookup_log2(model->compute_left_us, survivors) * 1000.0;
+}
+
+/**
+ * Decides whether scoring the next guess is expected to finish the game sooner
+ * than guessing the first survivor.
+ * @param solver The solver holding the dictionary, pattern matrix and prior.
+ * @param game The game state, with its round-trip and speed estimates.
+ * @return 1 to score, 0 to guess the first survivor.
+ *
+ * Note: Until a round trip has been measured, guesses are assumed to be
+ * expensive, so the game plays like the entropy strategy.
+ */
+int timing_worth_scoring(const Solver *solver, const GameState *game)
+{
+    const CandidateSet *candidates = &game->candidates;
+    if (game->rtt_ns == 0 || candidates->count <= 2)
+    {
+        return 1;
+    }
+
+    // The cheap move's buckets, by count and by prior weight
+    int cheap = candidates->index[0];
+    int sizes[NUM_PATTERNS] = {0};
+    double mass[NUM_PATTERNS] = {0};
+    double total = 0.0;
+    const double *weights = solver->prior.weights;
+    for (int i = 0; i < candidates->count; i++)
+    {
+        int answer = candidates->index[i];
+        int pattern = solver_pattern(solver, cheap, answer);
+        double weight = weights != NULL ? weights[answer] : 1.0;
+        sizes[pattern]++;
+        mass[pattern] += weight;
+        total += weight;
+    }
+    double cheap_guesses = 1.0;
+    double cheap_compute_ns = 0.0;
+    for (int p = 0; p < PATTERN_SOLVED; p++)
+    {
+        if (sizes[p] > 0)
+        {
+            cheap_guesses += mass[p] / total * timing_expected_guesses(&solver->timing, sizes[p]);
+            cheap_compute_ns += mass[p] / total * timing_expected_compute_ns(&solver->timing, sizes[p]);
+        }
+    }
+
+    double rtt_ns = (double)game->rtt_ns;
+    double score_ns =
+        rtt_ns * timing_expected_guesses(&solver->timing, candidates->count) +
+        game->speed * timing_expected_compute_ns(&solver->timing, candidates->count);
+    double cheap_ns = rtt_ns * cheap_guesses + game->speed * cheap_compute_ns;
+    return score_ns < cheap_ns;
+}
+
+/**
+ * Folds a measured round trip into the game's estimate.
+ * @param game The game state.
+ * @param ns The time from sending a guess to receiving its response.
+ */
+void timing_observe_rtt(GameState *game, uint64_t ns)
+{
+    if (game->rtt_ns == 0)
+    {
+        game->rtt_ns = ns > 0 ? ns : 1;
+        return;
+    }
+    game->rtt_ns = (uint64_t)((1.0 - TIMING_SMOOTHING) * (double)game->rtt_ns + TIMING_SMOOTHING * (double)ns);
+}
+
+/**
+ * Folds the time of a scoring decision into the game's speed estimate.
+ * @param model The time model the speed is relative to.
+ * @param game The game state.
+ * @param survivors The number of surviving candidates the decision was made for.
+ * @param ns The time the decision took.
+ */
+void timing_observe_decision(const TimingModel *model, GameState *game, int survivors, uint64_t ns)
+{
+    if (survivors <= 2)
+    {
+        return; // Too quick to say anything about the host
+    }
+    double ratio = (double)ns / (table_lookup_log2(model->decision_us, survivors) * 1000.0);
+    game->speed = (1.0 - TIMING_SMOOTHING) * game->speed + TIMING_SMOOTHING * ratio;
+}
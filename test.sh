@@ -22,4 +22,6 @@ echo "------------------------------------------------"
 ./client -p 27993 -s server.example.com username extra_argument
 echo "------------------------------------------------"
 
-
+# Test case 6: Unknown guess strategy
+./client -g unknown server.example.com username
+echo "------------------------------------------------"
@@ -0,0 +1,1285 @@
+/**
+ * Solver Tests for the 3700.network Project - Client Word Solver
+ *
+ * This program checks the solver against its reference implementations:
+ *
+ * - Every SIMD feedback kernel against feedback_block_scalar(), for every guess
+ *   with a repeated letter and every 7th other guess, against the whole word
+ *   list and against odd-sized subsets (to exercise the padding lanes).
+ * - Candidate narrowing with the letter index against constraint_allows() on
+ *   every word, for games with random secrets and guesses.
+ * - The opening book: a written book maps back, and one with a guess or
+ *   children out of range is not used.
+ * - The decision table: constraint states reached by the same guesses in another
+ *   order share a key, and a stored decision is found again.
+ * - The decision cache file: decisions survive a reopen, and compaction keeps
+ *   the latest decision of every key.
+ * - The answer prior: a recorded history loads back, and a uniform prior scores
+ *   every guess exactly like no prior.
+ * - Branch-and-bound scoring against scoring every word with entropy_score(),
+ *   with and without a prior and a worker pool.
+ * - Batched scoring: entropy_best_guesses() picks what entropy_best_guess()
+ *   picks for each survivor set of a batch, with and without a prior and a
+ *   worker pool, and decisions scoring the same guesses share their rows.
+ * - Fixed-point scoring against floating point on the full dictionary: every
+ *   guess scores the same to well within ENTROPY_EPSILON, and the same best
+ *   guess is picked.
+ * - Deadlines: a generous deadline picks the same guess as none, and a passed
+ *   one still returns a guess and records the hit.
+ * - The time model: a slow round trip makes every decision worth scoring, a
+ *   fast one leaves the expensive ones to first-fit.
+ * - Rebuilding a game from its list of guesses matches playing the guesses one
+ *   by one: same constraint state, same survivors. The list is also read back
+ *   from a server-style JSON response with retreive_hints(), and the client's
+ *   game loop takes a game over when the server records a guess it never made.
+ * - The game loop with the timed strategy deciding ahead while it waits for
+ *   the response (run under -fsanitize=thread to check the threads).
+ * - The strategy interface: the built-in survivor strategies and the example
+ *   plugin, loaded from plugin_example.so, play games through game_next_guess()
+ *   and only ever guess survivors, so every game ends solved. The frequency
+ *   strategy's incremental counts pick what counting from scratch picks.
+ * - The endgame search on small survivor sets against first-fit, which plays a
+ *   subset of the guesses the search considers and so can never cost less, and
+ *   on sets of 3 to 6 survivors against brute force over the same guesses.
+ *
+ * Usage: ./test_solver    (or make test, which also runs it built for 4 and 6 letters: make test-variants)
+ */
+
+#include "solver.h"
+#include "client.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static int failures = 0;
+
+#define CHECK(condition, ...)                 \
+    do                                        \
+    {                                         \
+        if (!(condition))                     \
+        {                                     \
+            fprintf(stderr, "FAIL: ");        \
+            fprintf(stderr, __VA_ARGS__);     \
+            fprintf(stderr, "\n");            \
+            failures++;                       \
+        }                                     \
+    } while (0)
+
+/**
+ * Returns 1 if a word repeats a letter.
+ */
+static int has_repeated_letter(const DictWord *word)
+{
+    return __builtin_popcount(word->mask) < WORD_LEN;
+}
+
+/**
+ * Compares one kernel with the scalar reference over a block of answers.
+ * @return The number of guesses compared.
+ */
+static int compare_kernel(const Dictionary *dict, FeedbackKernel kernel, const AnswerBlock *answers, const int *index)
+{
+    Pattern *expected = (Pattern *)aligned_alloc(32, answers->padded * sizeof(Pattern));
+    Pattern *actual = (Pattern *)aligned_alloc(32, answers->padded * sizeof(Pattern));
+    int compared = 0;
+
+    for (int g = 0; g < dict->num_words; g++)
+    {
+        if (!has_repeated_letter(&dict->words[g]) && g % 7 != 0)
+        {
+            continue;
+        }
+        feedback_block_scalar(&dict->words[g], answers, expected);
+        kernel.run(&dict->words[g], answers, actual);
+        for (int k = 0; k < answers->count; k++)
+        {
+            if (expected[k] != actual[k])
+            {
+                const char *answer = dict->words[index != NULL ? index[k] : k].text;
+                CHECK(0, "%s kernel: guess %s, answer %s: got %d, expected %d",
+                      kernel.name, dict->words[g].text, answer, actual[k], expected[k]);
+                break;
+            }
+        }
+        compared++;
+    }
+
+    free(expected);
+    free(actual);
+    return compared;
+}
+
+/**
+ * Differential test of the feedback kernels.
+ */
+static void test_feedback_kernels(const Dictionary *dict)
+{
+    FeedbackKernel kernels[FEEDBACK_MAX_KERNELS];
+    int num_kernels = feedback_kernels(kernels, FEEDBACK_MAX_KERNELS);
+
+#if WORD_LEN == 5
+    // Reference sanity checks with repeated letters (marks are listed from position 0)
+    static const struct
+    {
+        const char *guess;
+        const char *answer;
+        int marks[WORD_LEN];
+    } cases[] = {
+        {"speed", "abide", {0, 0, 1, 0, 1}},
+        {"eerie", "there", {1, 0, 1, 0, 2}},
+        {"llama", "hello", {1, 1, 0, 0, 0}},
+        {"geese", "elbow", {0, 1, 0, 0, 0}},
+        {"array", "arbor", {2, 2, 1, 0, 0}},
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        DictWord guess, answer;
+        word_encode(&guess, cases[c].guess);
+        word_encode(&answer, cases[c].answer);
+        CHECK(feedback_pattern(&guess, &answer) == pattern_from_marks(cases[c].marks),
+              "feedback_pattern(%s, %s)", cases[c].guess, cases[c].answer);
+    }
+#endif
+
+    // Whole word list
+    AnswerBlock answers;
+    CHECK(answer_block_init(&answers, dict, NULL, dict->num_words) == 0, "answer block: %d words not packed", dict->num_words);
+    for (int k = 1; k < num_kernels; k++)
+    {
+        int compared = compare_kernel(dict, kernels[k], &answers, NULL);
+        printf("%s kernel: %d guesses x %d answers\n", kernels[k].name, compared, answers.count);
+    }
+    answer_block_free(&answers);
+
+    // Odd-sized subsets, so the last SIMD step has padding lanes
+    int *index = (int *)malloc(dict->num_words * sizeof(int));
+    for (int size = 1; size <= 97; size += 16)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            index[i] = (i * 7919 + size) % dict->num_words;
+        }
+        CHECK(answer_block_init(&answers, dict, index, size) == 0, "answer block: %d words not packed", size);
+        for (int k = 1; k < num_kernels; k++)
+        {
+            compare_kernel(dict, kernels[k], &answers, index);
+        }
+        answer_block_free(&answers);
+    }
+    free(index);
+
+    if (num_kernels == 1)
+    {
+        printf("no SIMD kernel available on this CPU or for %d-letter words\n", WORD_LEN);
+    }
+}
+
+/**
+ * Differential test of the bitset narrowing.
+ */
+static void test_letter_index(const Dictionary *dict)
+{
+    srand(3700);
+    int games = 0;
+    for (int game = 0; game < 200; game++)
+    {
+        int answer = rand() % dict->num_words;
+        Constraint constraint;
+        constraint_init(&constraint);
+        CandidateSet candidates;
+        candidates_init(&candidates, dict);
+
+        for (int round = 0; round < 4 && candidates.count > 1; round++)
+        {
+            int guess = rand() % dict->num_words;
+            int marks[WORD_LEN];
+            pattern_to_marks(feedback_pattern(&dict->words[guess], &dict->words[answer]), marks);
+            constraint_apply(&constraint, dict->words[guess].text, marks);
+            candidates_narrow(&candidates, dict, &constraint);
+
+            int expected = 0;
+            for (int w = 0; w < dict->num_words; w++)
+            {
+                if (constraint_allows(&constraint, &dict->words[w]))
+                {
+                    CHECK(expected < candidates.count && candidates.index[expected] == w,
+                          "letter index: %s missing after guess %s (secret %s)",
+                          dict->words[w].text, dict->words[guess].text, dict->words[answer].text);
+                    expected++;
+                }
+            }
+            CHECK(expected == candidates.count, "letter index: %d survivors, expected %d", candidates.count, expected);
+        }
+        candidates_free(&candidates);
+        games++;
+    }
+
+    // Lookups through the index find every word where the word list has it
+    for (int w = 0; w < dict->num_words; w += 13)
+    {
+        CHECK(dict_find(dict, dict->words[w].text) == w, "letter index: %s not found", dict->words[w].text);
+    }
+    CHECK(dict_find(dict, "zzzzzzzz") == -1, "letter index: found a word that is not in the list");
+    printf("letter index: %d games\n", games);
+}
+
+/**
+ * Checks that a compiled dictionary maps back to the dictionary it was written from.
+ */
+static void test_dict_file(const Dictionary *dict)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/test_solver_%d.dict", (int)getpid());
+    CHECK(dict_write(dict, path, WORD_LIST_FILE) == 0, "compiled dictionary: cannot write %s", path);
+
+    Dictionary mapped;
+    CHECK(dict_open(&mapped, path, WORD_LIST_FILE) == 0, "compiled dictionary: cannot map %s", path);
+    size_t num_bits = (size_t)(2 * WORD_LEN * ALPHABET_SIZE) * dict->index.num_blocks;
+    CHECK(mapped.num_words == dict->num_words && dict_checksum(&mapped) == dict_checksum(dict) &&
+              memcmp(mapped.words, dict->words, dict->num_words * sizeof(DictWord)) == 0,
+          "compiled dictionary: words differ from the word list");
+    CHECK(mapped.index.num_blocks == dict->index.num_blocks &&
+              memcmp(mapped.index.bits, dict->index.bits, num_bits * sizeof(uint64_t)) == 0,
+          "compiled dictionary: letter index differs");
+    dict_free(&mapped);
+
+    // A file compiled from another word list is not used
+    CHECK(dict_open(&mapped, path, path) == -1, "compiled dictionary: mapped although its word list changed");
+
+    // Nor is a truncated file, or one with a damaged word
+    struct stat info;
+    CHECK(stat(path, &info) == 0 && truncate(path, info.st_size - 64) == 0, "compiled dictionary: cannot truncate %s", path);
+    CHECK(dict_open(&mapped, path, NULL) == -1, "compiled dictionary: mapped a truncated file");
+    CHECK(dict_write(dict, path, WORD_LIST_FILE) == 0, "compiled dictionary: cannot write %s", path);
+    FILE *damaged = fopen(path, "r+b");
+    CHECK(damaged != NULL && fseek(damaged, (long)(sizeof(DictFileHeader) + 10 * sizeof(DictWord)), SEEK_SET) == 0 &&
+              fputc('{', damaged) != EOF && fclose(damaged) == 0,
+          "compiled dictionary: cannot damage %s", path);
+    CHECK(dict_open(&mapped, path, NULL) == -1, "compiled dictionary: mapped a damaged word");
+
+    // Nor is a word list with words of another length compiled
+    FILE *file = fopen(path, "w");
+    fprintf(file, "%s\nlonger%s\n", dict->words[0].text, dict->words[1].text);
+    fclose(file);
+    Dictionary mixed;
+    CHECK(dict_load(&mixed, path) == 0 && mixed.num_words == 1 && mixed.num_rejected == 1 && dict_check(&mixed, path) == -1,
+          "compiled dictionary: a line of another length is accepted");
+    dict_free(&mixed);
+    unlink(path);
+    printf("compiled dictionary: %d words\n", dict->num_words);
+}
+
+/**
+ * Checks that an opening book maps back, and that one with a node out of range is not used.
+ */
+static void test_book(const Solver *solver)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/test_solver_%d.book", (int)getpid());
+    int num_nodes = book_write(solver, STRATEGY_FIRST_FIT, 2, path);
+    CHECK(num_nodes > 1, "opening book: cannot write %s", path);
+
+    OpeningBook book;
+    CHECK(book_open(&book, &solver->dict, path) == 0 && book.num_nodes == (uint32_t)num_nodes && book.nodes[0].guess == 0,
+          "opening book: %s does not map back", path);
+    book_close(&book);
+
+    // A node with a guess past the dictionary, or children past the last node
+    for (int field = 0; field < 2; field++)
+    {
+        CHECK(book_write(solver, STRATEGY_FIRST_FIT, 2, path) == num_nodes, "opening book: cannot write %s", path);
+        FILE *file = fopen(path, "r+b");
+        BookNode node;
+        long offset = (long)(sizeof(BookFileHeader) + (field == 0 ? num_nodes - 1 : 0) * sizeof(BookNode));
+        CHECK(file != NULL && fseek(file, offset, SEEK_SET) == 0 && fread(&node, sizeof(node), 1, file) == 1,
+              "opening book: cannot read %s", path);
+        if (field == 0)
+        {
+            node.guess = (uint32_t)solver->dict.num_words;
+        }
+        else
+        {
+            node.first_child = (uint32_t)num_nodes - 1;
+        }
+        CHECK(fseek(file, offset, SEEK_SET) == 0 && fwrite(&node, sizeof(node), 1, file) == 1 && fclose(file) == 0,
+              "opening book: cannot damage %s", path);
+        CHECK(book_open(&book, &solver->dict, path) == -1 && book.nodes == NULL,
+              "opening book: mapped a node out of range");
+    }
+    unlink(path);
+    printf("opening book: %d nodes\n", num_nodes);
+}
+
+/**
+ * Checks constraint hashing and the decision table.
+ */
+static void test_decision_table(const Dictionary *dict)
+{
+    srand(3702);
+    DecisionTable *table = table_create(12);
+    CHECK(table != NULL, "decision table: cannot allocate");
+    if (table == NULL)
+    {
+        return;
+    }
+
+    int checked = 0;
+    for (int game = 0; game < 1000; game++)
+    {
+        // The same three guesses against the same secret, applied in two orders
+        int answer = rand() % dict->num_words;
+        int guesses[3] = {rand() % dict->num_words, rand() % dict->num_words, rand() % dict->num_words};
+        Constraint forward, backward;
+        constraint_init(&forward);
+        constraint_init(&backward);
+        for (int i = 0; i < 3; i++)
+        {
+            int marks[WORD_LEN];
+            pattern_to_marks(feedback_pattern(&dict->words[guesses[i]], &dict->words[answer]), marks);
+            constraint_apply(&forward, dict->words[guesses[i]].text, marks);
+            pattern_to_marks(feedback_pattern(&dict->words[guesses[2 - i]], &dict->words[answer]), marks);
+            constraint_apply(&backward, dict->words[guesses[2 - i]].text, marks);
+        }
+        uint64_t key = constraint_hash(&forward, 0);
+        CHECK(key == constraint_hash(&backward, 0), "decision table: guess order changes the key (secret %s)",
+              dict->words[answer].text);
+        CHECK(key != constraint_hash(&forward, 1), "decision table: the seed does not change the key");
+
+        table_store(table, key, answer);
+        CHECK(table_lookup(table, key) == answer, "decision table: stored decision for %s not found",
+              dict->words[answer].text);
+        checked++;
+    }
+
+    uint64_t lookups, hits;
+    table_stats(table, &lookups, &hits);
+    CHECK(lookups == (uint64_t)checked && hits == (uint64_t)checked, "decision table: %llu hits of %llu lookups",
+          (unsigned long long)hits, (unsigned long long)lookups);
+    table_destroy(table);
+    printf("decision table: %d states\n", checked);
+}
+
+/**
+ * Checks that decisions are kept in the cache file and compacted.
+ */
+static void test_decision_cache(const Dictionary *dict)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/test_solver_%d.bin", (int)getpid());
+    unlink(path);
+
+    // Every key is written twice, the second time with another guess
+    DecisionTable *table = table_create(12);
+    DecisionCache cache;
+    CHECK(cache_open(&cache, dict, table, path) == 0, "decision cache: new file is not empty");
+    for (int round = 0; round < 2; round++)
+    {
+        for (int k = 0; k < 100; k++)
+        {
+            cache_append(&cache, 1000 + k, k + round);
+        }
+    }
+
+    // Not compacted while a client has the file open, since its appends would be lost
+    CHECK(cache_compact(dict, path, NULL) == -1 && errno == EWOULDBLOCK, "decision cache: compacted while open");
+    cache_close(&cache);
+    table_destroy(table);
+
+    int num_entries = 0;
+    int kept = cache_compact(dict, path, &num_entries);
+    CHECK(num_entries == 200 && kept == 100, "decision cache: %d entries compacted to %d", num_entries, kept);
+
+    table = table_create(12);
+    CHECK(cache_open(&cache, dict, table, path) == 100, "decision cache: compacted file does not load");
+    for (int k = 0; k < 100; k++)
+    {
+        CHECK(table_lookup(table, 1000 + k) == k + 1, "decision cache: key %d lost its latest decision", k);
+    }
+    cache_close(&cache);
+    table_destroy(table);
+    unlink(path);
+    printf("decision cache: %d entries\n", num_entries);
+}
+
+/**
+ * Checks the answer prior against the unweighted entropy.
+ */
+static void test_prior(Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/test_solver_%d.txt", (int)getpid());
+    unlink(path);
+
+    history_record(path, dict->words[10].text);
+    history_record(path, dict->words[10].text);
+    history_record(path, dict->words[20].text);
+    history_record(path, "zzzzz"); // Not a word, skipped
+    CHECK(solver_set_prior(solver, path) == 3, "prior: %d games loaded, expected 3", solver->prior.num_games);
+    CHECK(solver->prior.weights != NULL && solver->prior.weights[10] == 2 + PRIOR_SMOOTHING &&
+              solver->prior.weights[20] == 1 + PRIOR_SMOOTHING && solver->prior.weights[30] == PRIOR_SMOOTHING,
+          "prior: wrong weights");
+    unlink(path);
+
+#ifdef ENTROPY_OPENER
+    // The precomputed opener was picked without a prior, so a prior that favours words without its letters has
+    // its opener scored
+    double *weights = (double *)malloc(dict->num_words * sizeof(double));
+    memcpy(weights, solver->prior.weights, dict->num_words * sizeof(double));
+    for (int w = 0; w < dict->num_words; w++)
+    {
+        if (strpbrk(dict->words[w].text, ENTROPY_OPENER) == NULL)
+        {
+            solver->prior.weights[w] = 1000.0;
+        }
+    }
+    CandidateSet everything;
+    candidates_init(&everything, dict);
+    int opener = strategy_ops(STRATEGY_ENTROPY)->next_guess(NULL, solver, &everything, NULL);
+    CHECK(opener == entropy_best_guess(solver, &everything, NULL), "prior: opener %s is not the weighted best guess",
+          opener >= 0 ? dict->words[opener].text : "none");
+    CHECK(opener != dict_find(dict, ENTROPY_OPENER), "prior: opener %s kept", ENTROPY_OPENER);
+    candidates_free(&everything);
+    memcpy(solver->prior.weights, weights, dict->num_words * sizeof(double));
+    free(weights);
+#endif
+
+    // Random survivor sets, scored without a prior and with a uniform one
+    srand(3703);
+    int scored = 0;
+    for (int w = 0; w < dict->num_words; w++)
+    {
+        solver->prior.weights[w] = PRIOR_SMOOTHING;
+    }
+    int *index = (int *)malloc(dict->num_words * sizeof(int));
+    for (int set = 0; set < 20; set++)
+    {
+        CandidateSet candidates = {index, 0, NULL};
+        for (int w = 0; w < dict->num_words; w++)
+        {
+            if (rand() % 40 == 0)
+            {
+                index[candidates.count++] = w;
+            }
+        }
+        for (int k = 0; k < 50; k++)
+        {
+            int guess = rand() % dict->num_words;
+            double weighted = entropy_score(solver, guess, &candidates);
+            double *weights = solver->prior.weights;
+            solver->prior.weights = NULL;
+            double uniform = entropy_score(solver, guess, &candidates);
+            solver->prior.weights = weights;
+            CHECK(fabs(weighted - uniform) < 1e-9, "prior: uniform prior scores %s %.12f, expected %.12f",
+                  dict->words[guess].text, weighted, uniform);
+            scored++;
+        }
+    }
+    free(index);
+    prior_free(&solver->prior);
+    printf("prior: %d guesses\n", scored);
+}
+
+/**
+ * Picks the best guess by scoring every dictionary word.
+ */
+static int exhaustive_best_guess(const Solver *solver, const CandidateSet *candidates)
+{
+    GuessChoice best = {-1, 0.0, 0, 0};
+    int next_candidate = 0;
+    for (int g = 0; g < solver->dict.num_words; g++)
+    {
+        GuessChoice choice = {g, entropy_score(solver, g, candidates), 0, 0};
+        if (next_candidate < candidates->count && candidates->index[next_candidate] == g)
+        {
+            choice.is_candidate = 1;
+            next_candidate++;
+        }
+        if (choice_better(&choice, &best))
+        {
+            best = choice;
+        }
+    }
+    return best.guess;
+}
+
+/**
+ * Differential test of the fixed-point guess scoring against floating point.
+ */
+static void test_fixed_point(Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    CandidateSet candidates;
+    candidates_init(&candidates, dict);
+
+    // Every guess over every answer
+    double worst = 0.0;
+    double scale = (double)candidates.count * (double)(1ull << ENTROPY_FIXED_BITS);
+    for (int g = 0; g < dict->num_words; g++)
+    {
+        double fixed = log2((double)candidates.count) - (double)entropy_cost(solver, g, &candidates) / scale;
+        double error = fabs(fixed - entropy_score(solver, g, &candidates));
+        if (error > worst)
+        {
+            worst = error;
+        }
+    }
+    CHECK(worst < ENTROPY_EPSILON / 100, "fixed point: scores differ by up to %.3g bits", worst);
+
+    int expected = exhaustive_best_guess(solver, &candidates);
+    int actual = entropy_best_guess(solver, &candidates, NULL);
+    CHECK(actual == expected, "fixed point: %s over the dictionary, expected %s", dict->words[actual].text,
+          dict->words[expected].text);
+#ifdef ENTROPY_OPENER
+    CHECK(strcmp(dict->words[actual].text, ENTROPY_OPENER) == 0, "fixed point: %s over the dictionary, expected %s",
+          dict->words[actual].text, ENTROPY_OPENER);
+#endif
+
+    candidates_free(&candidates);
+    printf("fixed point: %d guesses, largest error %.3g bits\n", dict->num_words, worst);
+}
+
+/**
+ * Differential test of the branch-and-bound guess scoring.
+ */
+static void test_pruned_scoring(Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    srand(3705);
+    int *index = (int *)malloc(dict->num_words * sizeof(int));
+    int decisions = 0;
+    for (int set = 0; set < 24; set++)
+    {
+        // Survivor sets of a real game, from a few hundred words down to a handful
+        int answer = rand() % dict->num_words;
+        Constraint constraint;
+        constraint_init(&constraint);
+        CandidateSet game;
+        candidates_init(&game, dict);
+        for (int round = 0; round < 1 + set % 3; round++)
+        {
+            int guess = rand() % dict->num_words;
+            int marks[WORD_LEN];
+            pattern_to_marks(solver_pattern(solver, guess, answer), marks);
+            constraint_apply(&constraint, dict->words[guess].text, marks);
+            candidates_narrow(&game, dict, &constraint);
+        }
+        CandidateSet candidates = {index, game.count, NULL};
+        memcpy(index, game.index, game.count * sizeof(int));
+        candidates_free(&game);
+        if (candidates.count < 3)
+        {
+            continue;
+        }
+
+        // Every other set with a skewed prior, every fourth with a worker pool
+        if (set % 2 == 1)
+        {
+            solver->prior.weights = (double *)malloc(dict->num_words * sizeof(double));
+            for (int w = 0; w < dict->num_words; w++)
+            {
+                solver->prior.weights[w] = PRIOR_SMOOTHING + (w % 7 == 0 ? 3 : 0);
+            }
+        }
+        solver_set_threads(solver, set % 4 == 3 ? 3 : 1);
+
+        int expected = exhaustive_best_guess(solver, &candidates);
+        int actual = entropy_best_guess(solver, &candidates, NULL);
+        CHECK(actual == expected, "pruned scoring: %s for %d survivors, expected %s%s", dict->words[actual].text,
+              candidates.count, dict->words[expected].text, solver->prior.weights != NULL ? " (prior)" : "");
+        decisions++;
+
+        solver_set_threads(solver, 1);
+        prior_free(&solver->prior);
+    }
+    free(index);
+    printf("pruned scoring: %d decisions\n", decisions);
+}
+
+/**
+ * Differential test of the batched scoring against one decision at a time.
+ */
+static void test_batch(Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    srand(3706);
+    CandidateSet games[32];
+    const CandidateSet *sets[32];
+    for (int set = 0; set < 32; set++)
+    {
+        // Survivor sets of real games after one or two guesses, some of them twice
+        games[set].index = NULL;
+        if (set % 8 == 7)
+        {
+            sets[set] = sets[set - 1];
+            continue;
+        }
+        int answer = rand() % dict->num_words;
+        Constraint constraint;
+        constraint_init(&constraint);
+        candidates_init(&games[set], dict);
+        for (int round = 0; round < 1 + set % 2; round++)
+        {
+            int guess = rand() % dict->num_words;
+            int marks[WORD_LEN];
+            pattern_to_marks(solver_pattern(solver, guess, answer), marks);
+            constraint_apply(&constraint, dict->words[guess].text, marks);
+            candidates_narrow(&games[set], dict, &constraint);
+        }
+        if (set == 3)
+        {
+            // Two survivors, the second one likelier under the prior
+            games[set].index[0] = 1;
+            games[set].index[1] = 5;
+            games[set].count = 2;
+        }
+        sets[set] = &games[set];
+    }
+
+    int decisions = 0;
+    for (int run = 0; run < 4; run++)
+    {
+        // With and without a prior, on the calling thread and on a pool of three workers
+        int weighted = run % 2;
+        solver_set_threads(solver, run >= 2 ? 3 : 1);
+        if (weighted)
+        {
+            solver->prior.weights = (double *)malloc(dict->num_words * sizeof(double));
+            for (int w = 0; w < dict->num_words; w++)
+            {
+                solver->prior.weights[w] = PRIOR_SMOOTHING + (w % 5 == 0 ? 2 : 0);
+            }
+        }
+        int guesses[32];
+        entropy_best_guesses(solver, sets, 32, guesses);
+        for (int set = 0; set < 32; set++)
+        {
+            int expected = entropy_best_guess(solver, sets[set], NULL);
+            CHECK(guesses[set] == expected, "batch: %s for %d survivors, expected %s%s%s", dict->words[guesses[set]].text,
+                  sets[set]->count, dict->words[expected].text, weighted ? " (prior)" : "", run >= 2 ? " (pool)" : "");
+            decisions++;
+        }
+
+        // Decisions scoring the same guesses read each row once (without a matrix they are decided one by one)
+        const CandidateSet *same[2] = {sets[0], sets[0]};
+        int rows_one = entropy_best_guesses(solver, same, 1, guesses);
+        int rows_two = entropy_best_guesses(solver, same, 2, guesses);
+        CHECK(solver->matrix.data == NULL || (rows_one > 0 && rows_two == rows_one),
+              "batch: %d rows read for two identical decisions, %d for one", rows_two, rows_one);
+        CHECK(guesses[3] == (weighted ? 5 : 1), "batch: %s of two survivors%s", dict->words[guesses[3]].text,
+              weighted ? " (prior)" : "");
+        prior_free(&solver->prior);
+    }
+    solver_set_threads(solver, 1);
+    for (int set = 0; set < 32; set++)
+    {
+        if (games[set].index != NULL)
+        {
+            candidates_free(&games[set]);
+        }
+    }
+    printf("batch: %d decisions\n", decisions);
+}
+
+/**
+ * Checks that deadlines only change a decision when they pass.
+ */
+static void test_deadline(const Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    srand(3704);
+    int *index = (int *)malloc(dict->num_words * sizeof(int));
+    int decisions = 0;
+    for (int set = 0; set < 5; set++)
+    {
+        CandidateSet candidates = {index, 0, NULL};
+        for (int w = 0; w < dict->num_words; w++)
+        {
+            if (rand() % 100 == 0)
+            {
+                index[candidates.count++] = w;
+            }
+        }
+
+        Deadline generous;
+        deadline_start(&generous, 60 * 1000 * 1000);
+        int expected = entropy_best_guess(solver, &candidates, NULL);
+        CHECK(entropy_best_guess(solver, &candidates, &generous) == expected && !generous.expired,
+              "deadline: a generous deadline changed the guess");
+
+        Deadline passed;
+        deadline_start(&passed, 1);
+        while (!deadline_passed(&passed))
+        {
+        }
+        int guess = entropy_best_guess(solver, &candidates, &passed);
+        CHECK(guess >= 0 && guess < dict->num_words && passed.expired, "deadline: no guess at a passed deadline");
+        decisions += 2;
+    }
+    free(index);
+    printf("deadline: %d decisions\n", decisions);
+}
+
+/**
+ * Plays every answer of a survivor set by always guessing the first survivor.
+ * @return The worst-case and total number of guesses.
+ */
+static EndgameCost play_first_fit(const Solver *solver, const CandidateSet *survivors)
+{
+    EndgameCost cost = {0, 0};
+    int *index = (int *)malloc(survivors->count * sizeof(int));
+    for (int a = 0; a < survivors->count; a++)
+    {
+        int answer = survivors->index[a];
+        int count = survivors->count;
+        memcpy(index, survivors->index, count * sizeof(int));
+
+        int guesses = 1;
+        while (index[0] != answer)
+        {
+            int guess = index[0];
+            int pattern = solver_pattern(solver, guess, answer);
+            int kept = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (solver_pattern(solver, guess, index[i]) == pattern)
+                {
+                    index[kept++] = index[i];
+                }
+            }
+            count = kept;
+            guesses++;
+        }
+        cost.total += guesses;
+        if (guesses > cost.depth)
+        {
+            cost.depth = guesses;
+        }
+    }
+    free(index);
+    return cost;
+}
+
+#define BRUTE_MAX 6 // Largest survivor set searched by brute force
+
+/**
+ * Solves a subset of a small survivor set by brute force, with the search's
+ * recursion: every guess of the subset and of extras is tried, and the buckets
+ * are solved on their own.
+ * @param root The survivor set, at most BRUTE_MAX words.
+ * @param mask The subset of root, one bit per word.
+ * @param extras The guesses tried besides the subset.
+ * @param memo Costs of the subsets solved so far, depth 0 when not yet solved.
+ */
+static EndgameCost brute_force(const Solver *solver, const int *root, int mask, const int *extras, int num_extras,
+                               EndgameCost *memo)
+{
+    int subset[BRUTE_MAX];
+    int count = 0;
+    for (int i = 0; i < BRUTE_MAX; i++)
+    {
+        if (mask & 1 << i)
+        {
+            subset[count++] = root[i];
+        }
+    }
+    if (count <= 2)
+    {
+        EndgameCost cost = {count, 2 * count - 1};
+        return cost;
+    }
+    if (memo[mask].depth != 0)
+    {
+        return memo[mask];
+    }
+
+    EndgameCost best = {0, 0};
+    for (int k = 0; k < count + num_extras; k++)
+    {
+        int guess = k < count ? subset[k] : extras[k - count];
+        int patterns[BRUTE_MAX];
+        for (int i = 0; i < BRUTE_MAX; i++)
+        {
+            patterns[i] = mask & 1 << i ? solver_pattern(solver, guess, root[i]) : -1;
+        }
+        EndgameCost cost = {1, count};
+        int done = 0; // Words already in a bucket
+        for (int i = 0; i < BRUTE_MAX; i++)
+        {
+            if (!(mask & 1 << i) || (done & 1 << i) || patterns[i] == PATTERN_SOLVED)
+            {
+                continue;
+            }
+            int bucket = 0;
+            for (int j = i; j < BRUTE_MAX; j++)
+            {
+                if (patterns[j] == patterns[i])
+                {
+                    bucket |= 1 << j;
+                }
+            }
+            done |= bucket;
+            if (bucket == mask)
+            {
+                cost.depth = 0; // Does not split the survivors
+                break;
+            }
+            EndgameCost sub = brute_force(solver, root, bucket, extras, num_extras, memo);
+            cost.total += sub.total;
+            if (1 + sub.depth > cost.depth)
+            {
+                cost.depth = 1 + sub.depth;
+            }
+        }
+        if (cost.depth != 0 && (best.depth == 0 || cost.depth < best.depth || (cost.depth == best.depth && cost.total < best.total)))
+        {
+            best = cost;
+        }
+    }
+    memo[mask] = best;
+    return best;
+}
+
+/**
+ * Checks the endgame search on the survivor sets of random games.
+ */
+static void test_endgame(const Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    srand(3701);
+    int sets = 0;
+    while (sets < 20)
+    {
+        int answer = rand() % dict->num_words;
+        Constraint constraint;
+        constraint_init(&constraint);
+        CandidateSet candidates;
+        candidates_init(&candidates, dict);
+        while (candidates.count > ENDGAME_MAX_CANDIDATES)
+        {
+            int guess = rand() % dict->num_words;
+            int marks[WORD_LEN];
+            pattern_to_marks(solver_pattern(solver, guess, answer), marks);
+            constraint_apply(&constraint, dict->words[guess].text, marks);
+            candidates_narrow(&candidates, dict, &constraint);
+        }
+
+        if (candidates.count >= 3)
+        {
+            EndgameCost cost = {0, 0};
+            int guess = endgame_best_guess(solver, &candidates, 10000, NULL, &cost);
+            EndgameCost first_fit = play_first_fit(solver, &candidates);
+            CHECK(guess >= 0, "endgame: no guess for %d survivors", candidates.count);
+            CHECK(cost.total >= 2 * candidates.count - 1 && cost.depth >= 2,
+                  "endgame: %d survivors cannot take %d guesses (worst %d)", candidates.count, cost.total, cost.depth);
+            CHECK(cost.depth < first_fit.depth || (cost.depth == first_fit.depth && cost.total <= first_fit.total),
+                  "endgame: %d survivors take %d guesses (worst %d), first-fit %d (worst %d)",
+                  candidates.count, cost.total, cost.depth, first_fit.total, first_fit.depth);
+            sets++;
+        }
+        candidates_free(&candidates);
+    }
+
+    // Small sets against brute force, over the same guesses and over every word
+    int *everything = (int *)malloc(dict->num_words * sizeof(int));
+    for (int w = 0; w < dict->num_words; w++)
+    {
+        everything[w] = w;
+    }
+    int small = 0;
+    int beaten = 0;
+    while (small < 20)
+    {
+        int answer = rand() % dict->num_words;
+        Constraint constraint;
+        constraint_init(&constraint);
+        CandidateSet candidates;
+        candidates_init(&candidates, dict);
+        while (candidates.count > BRUTE_MAX)
+        {
+            int guess = rand() % dict->num_words;
+            int marks[WORD_LEN];
+            pattern_to_marks(solver_pattern(solver, guess, answer), marks);
+            constraint_apply(&constraint, dict->words[guess].text, marks);
+            candidates_narrow(&candidates, dict, &constraint);
+        }
+
+        if (candidates.count >= 3)
+        {
+            EndgameCost cost = {0, 0};
+            endgame_best_guess(solver, &candidates, 10000, NULL, &cost);
+            int probes[ENDGAME_PROBES];
+            int num_probes = entropy_best_probes(solver, &candidates, ENDGAME_PROBES, probes, NULL);
+            EndgameCost memo[1 << BRUTE_MAX];
+            memset(memo, 0, sizeof(memo));
+            int all = (1 << candidates.count) - 1;
+            EndgameCost same = brute_force(solver, candidates.index, all, probes, num_probes, memo);
+            memset(memo, 0, sizeof(memo));
+            EndgameCost best = brute_force(solver, candidates.index, all, everything, dict->num_words, memo);
+            CHECK(cost.depth == same.depth && cost.total == same.total,
+                  "endgame: %d survivors take %d guesses (worst %d), brute force over the same guesses %d (worst %d)",
+                  candidates.count, cost.total, cost.depth, same.total, same.depth);
+            CHECK(best.depth < cost.depth || (best.depth == cost.depth && best.total <= cost.total),
+                  "endgame: %d survivors take %d guesses (worst %d), fewer than the best over every word, %d (worst %d)",
+                  candidates.count, cost.total, cost.depth, best.total, best.depth);
+            beaten += best.depth != cost.depth || best.total != cost.total;
+            small++;
+        }
+        candidates_free(&candidates);
+    }
+    free(everything);
+    printf("endgame: %d survivor sets, %d small ones against brute force (%d beaten by a word outside the root probes)\n",
+           sets, small, beaten);
+}
+
+/**
+ * Checks the timed strategy's choice between scoring and first-fit.
+ */
+static void test_time_model(const Solver *solver)
+{
+    // Survivors of a game that made one uninformative guess
+    GameState game;
+    game_init(&game, solver);
+#if WORD_LEN == 5
+    const char *guess = "fuzzy";
+#else
+    char guess[WORD_LEN + 1];
+    memcpy(guess, "zqxjkvwy", WORD_LEN); // Rare letters
+    guess[WORD_LEN] = '\0';
+#endif
+    int marks[WORD_LEN] = {0};
+    game_observe(&game, solver, guess, marks);
+
+    for (int n = 2; n < solver->dict.num_words; n *= 2)
+    {
+        CHECK(timing_expected_guesses(&solver->timing, n) <= timing_expected_guesses(&solver->timing, 2 * n),
+              "time model: fewer guesses for %d survivors than %d", 2 * n, n);
+    }
+    CHECK(timing_worth_scoring(solver, &game), "time model: no round trip measured, yet not scoring");
+
+    timing_observe_rtt(&game, 10ull * 1000 * 1000 * 1000);
+    CHECK(timing_worth_scoring(solver, &game), "time model: not scoring for %d survivors with a 10 s round trip",
+          game.candidates.count);
+
+    game.rtt_ns = 1000;
+    CHECK(!timing_worth_scoring(solver, &game), "time model: scoring %d survivors with a 1 us round trip",
+          game.candidates.count);
+
+    // A host that turns out ten times slower makes scoring look worse
+    game.rtt_ns = 0;
+    timing_observe_rtt(&game, 1000);
+    timing_observe_decision(&solver->timing, &game, game.candidates.count,
+                            (uint64_t)(10 * timing_expected_compute_ns(&solver->timing, game.candidates.count)));
+    CHECK(game.speed > 1.0, "time model: speed %.2f after a slow decision", game.speed);
+
+    // A measured model reads back as written, and one measured on another word list is ignored
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/test_solver_%d.timing", (int)getpid());
+    TimingModel model = solver->timing;
+    model.decision_us[3] *= 2.0;
+    model.compute_left_us[3] *= 2.0;
+    CHECK(timing_write(&model, &solver->dict, path) == 0, "time model: cannot write %s", path);
+    TimingModel loaded;
+    timing_init(&loaded, &solver->dict);
+    CHECK(timing_load(&loaded, &solver->dict, path) == 0 && loaded.measured &&
+              fabs(loaded.decision_us[3] - model.decision_us[3]) < 1.0 &&
+              fabs(loaded.guesses[3] - model.guesses[3]) < 0.01,
+          "time model: %s does not read back", path);
+    Dictionary other = solver->dict;
+    other.num_words--;
+    TimingModel unchanged = loaded;
+    CHECK(timing_load(&loaded, &other, path) == -1 && memcmp(&loaded, &unchanged, sizeof(loaded)) == 0,
+          "time model: loaded a model measured on another word list");
+    unlink(path);
+
+    printf("time model: %d survivors\n", game.candidates.count);
+    game_free(&game);
+}
+
+/**
+ * Writes guesses as the server's JSON response to a guess.
+ */
+static void format_response(char *buffer, size_t size, const GuessRecord *history, int count)
+{
+    size_t length = (size_t)snprintf(buffer, size, "{\"id\": \"test\", \"type\": \"retry\", \"guesses\": [");
+    for (int g = 0; g < count && length < size; g++)
+    {
+        length += (size_t)snprintf(buffer + length, size - length, "%s{\"word\": \"%s\", \"marks\": [", g > 0 ? ", " : "",
+                                   history[g].word);
+        for (int i = 0; i < WORD_LEN && length < size; i++)
+        {
+            length += (size_t)snprintf(buffer + length, size - length, "%s%d", i > 0 ? ", " : "", history[g].marks[i]);
+        }
+        if (length < size)
+        {
+            length += (size_t)snprintf(buffer + length, size - length, "]}");
+        }
+    }
+    if (length < size)
+    {
+        snprintf(buffer + length, size - length, "]}");
+    }
+}
+
+/**
+ * A stand-in for the server: answers guesses against a secret and keeps the
+ * game's record, which may open with a guess made by another client.
+ */
+typedef struct
+{
+    const Solver *solver;
+    int answer;
+    GuessRecord record[GAME_MAX_HISTORY];
+    int count;
+    int delay_us; // Round trip of every exchange
+    char response[8192];
+} TestServer;
+
+static int test_server_exchange(void *context, int guess, const char *word, int *marks, GuessRecord *history, int *num_history)
+{
+    TestServer *server = (TestServer *)context;
+    (void)word;
+    if (server->delay_us > 0)
+    {
+        usleep(server->delay_us);
+    }
+    if (guess == server->answer)
+    {
+        return 1;
+    }
+    if (server->count == GAME_MAX_HISTORY)
+    {
+        return -1;
+    }
+    GuessRecord *record = &server->record[server->count++];
+    memcpy(record->word, server->solver->dict.words[guess].text, WORD_LEN + 1);
+    pattern_to_marks(solver_pattern(server->solver, guess, server->answer), record->marks);
+
+    // What the client gets is the JSON response
+    format_response(server->response, sizeof(server->response), server->record, server->count);
+    *num_history = retreive_hints(server->response, history, GAME_MAX_HISTORY);
+    if (*num_history <= 0)
+    {
+        *num_history = 0;
+        return -1;
+    }
+    memcpy(marks, history[*num_history - 1].marks, sizeof(history[0].marks));
+    return 0;
+}
+
+/**
+ * Checks game_rebuild() against folding in the same guesses one at a time.
+ */
+static void test_rebuild(const Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    srand(3707);
+    int games = 0;
+    for (int game = 0; game < 100; game++)
+    {
+        int answer = rand() % dict->num_words;
+        GameState played;
+        game_init(&played, solver);
+        GuessRecord history[6];
+        int count = 1 + game % 6;
+        for (int g = 0; g < count; g++)
+        {
+            int guess = rand() % dict->num_words;
+            memcpy(history[g].word, dict->words[guess].text, WORD_LEN + 1);
+            pattern_to_marks(solver_pattern(solver, guess, answer), history[g].marks);
+            game_observe(&played, solver, history[g].word, history[g].marks);
+        }
+
+        // Read the guesses back from the server's response
+        char response[2048];
+        GuessRecord parsed[6];
+        format_response(response, sizeof(response), history, count);
+        CHECK(retreive_hints(response, parsed, 6) == count, "rebuild: response not read back: %s", response);
+
+        GameState rebuilt;
+        CHECK(game_rebuild(&rebuilt, solver, parsed, count) == 0, "rebuild: %d guesses rejected", count);
+        CHECK(constraint_hash(&rebuilt.constraint, 0) == constraint_hash(&played.constraint, 0),
+              "rebuild: constraint state differs after %d guesses (secret %s)", count, dict->words[answer].text);
+        CHECK(rebuilt.num_guesses == played.num_guesses, "rebuild: %d guesses, expected %d", rebuilt.num_guesses,
+              played.num_guesses);
+        CHECK(rebuilt.candidates.count == played.candidates.count &&
+                  memcmp(rebuilt.candidates.index, played.candidates.index, played.candidates.count * sizeof(int)) == 0,
+              "rebuild: %d survivors, expected %d (secret %s)", rebuilt.candidates.count, played.candidates.count,
+              dict->words[answer].text);
+        game_free(&rebuilt);
+
+        // A mark the server never sends
+        history[count - 1].marks[0] = 3;
+        CHECK(game_rebuild(&rebuilt, solver, history, count) == -1, "rebuild: mark 3 accepted");
+        game_free(&rebuilt);
+        uint64_t hash = constraint_hash(&played.constraint, 0);
+        int survivors = played.candidates.count;
+        CHECK(game_observe(&played, solver, history[count - 1].word, history[count - 1].marks) == -1 &&
+                  constraint_hash(&played.constraint, 0) == hash && played.candidates.count == survivors &&
+                  played.num_guesses == count,
+              "rebuild: mark 3 observed");
+        if (game == 0)
+        {
+            format_response(response, sizeof(response), history, count);
+            CHECK(retreive_hints(response, parsed, 6) == -1, "rebuild: mark 3 read back");
+        }
+        game_free(&played);
+        games++;
+    }
+
+    // The client's game loop, against a server whose record opens with another client's guess every other game
+    GameOptions options = {STRATEGY_FIRST_FIT, 1, 0, 0};
+    int resynced = 0;
+    for (int game = 0; game < 20; game++)
+    {
+        TestServer server;
+        server.solver = solver;
+        server.answer = rand() % dict->num_words;
+        server.count = 0;
+        server.delay_us = 0;
+        if (game % 2 == 1)
+        {
+            int other = (server.answer + 1 + rand() % (dict->num_words - 1)) % dict->num_words;
+            memcpy(server.record[0].word, dict->words[other].text, WORD_LEN + 1);
+            pattern_to_marks(solver_pattern(solver, other, server.answer), server.record[0].marks);
+            server.count = 1;
+        }
+        GameStats stats;
+        play_rounds(solver, &options, test_server_exchange, &server, &stats);
+        CHECK(stats.solved, "rebuild: game loop did not solve %s", dict->words[server.answer].text);
+        CHECK(stats.resyncs == game % 2, "rebuild: %d resyncs, expected %d", stats.resyncs, game % 2);
+        resynced += stats.resyncs;
+        games++;
+    }
+    printf("rebuild: %d games, %d taken over from the server's record\n", games, resynced);
+}
+
+/**
+ * Plays the client's game loop with the timed strategy, deciding ahead while
+ * the response is on its way, as the client does. The round trip is measured
+ * into the game only once the speculation has stopped reading it.
+ */
+static void test_speculation(const Solver *solver)
+{
+    const Dictionary *dict = &solver->dict;
+    GameOptions options = {STRATEGY_TIMED, 1, 0, 1};
+    srand(3708);
+    int games = 0;
+    int speculated = 0;
+    for (int game = 0; game < 10; game++)
+    {
+        TestServer server;
+        server.solver = solver;
+        server.answer = rand() % dict->num_words;
+        server.count = 0;
+        server.delay_us = 2000;
+        GameStats stats;
+        play_rounds(solver, &options, test_server_exchange, &server, &stats);
+        CHECK(stats.solved, "speculation: game loop did not solve %s", dict->words[server.answer].text);
+        speculated += stats.speculated;
+        games++;
+    }
+    CHECK(speculated > 0, "speculation: no decision made ahead in %d games", games);
+    printf("speculation: %d games, %d decisions made ahead\n", games, speculated);
+}
+
+/**
+ * Plays games with the strategies that only guess survivors, built in and loaded.
+ */
+static void test_strategies(const Solver *solver)
+{
+    Strategy strategies[3] = {STRATEGY_FIRST_FIT, STRATEGY_FREQUENCY, STRATEGY_FIRST_FIT};
+    int num_strategies = 2;
+    if (strategy_from_name("./plugin_example.so", &strategies[2]) == 0)
+    {
+        CHECK(strcmp(strategy_name(strategies[2]), "example") == 0, "strategies: plugin named %s", strategy_name(strategies[2]));
+        num_strategies++;
+    }
+    else
+    {
+        CHECK(0, "strategies: plugin_example.so not loaded (make plugins)");
+    }
+
+    const Dictionary *dict = &solver->dict;
+    srand(3700);
+    int games = 0;
+    for (int game = 0; game < 100; game++)
+    {
+        int answer = rand() % dict->num_words;
+        for (int s = 0; s < num_strategies; s++)
+        {
+            GameState state;
+            game_init(&state, solver);
+            int solved = 0;
+            while (!solved && state.candidates.count > 0)
+            {
+                int guess = game_next_guess(&state, solver, strategies[s]);
+                if (strategies[s] == STRATEGY_FREQUENCY)
+                {
+                    int expected = frequency_best_guess(solver, &state.candidates);
+                    CHECK(guess == expected, "strategies: frequency guessed %d with %d survivors, recounting gives %d", guess,
+                          state.candidates.count, expected);
+                }
+                int survives = 0;
+                for (int k = 0; k < state.candidates.count && !survives; k++)
+                {
+                    survives = state.candidates.index[k] == guess;
+                }
+                if (!survives)
+                {
+                    CHECK(0, "strategies: %s guessed %d, not a survivor (secret %s)", strategy_name(strategies[s]), guess,
+                          dict->words[answer].text);
+                    break;
+                }
+                int marks[WORD_LEN];
+                pattern_to_marks(feedback_pattern(&dict->words[guess], &dict->words[answer]), marks);
+                solved = game_observe(&state, solver, dict->words[guess].text, marks) == PATTERN_SOLVED;
+            }
+            CHECK(solved, "strategies: %s did not solve %s", strategy_name(strategies[s]), dict->words[answer].text);
+            game_free(&state);
+        }
+        games++;
+    }
+    printf("strategies: %d games with %d strategies\n", games, num_strategies);
+}
+
+int main(void)
+{
+    // The pattern matrix only speeds up the endgame checks
+    Solver solver;
+    if (solver_open(&solver, WORD_LIST_FILE, NULL, PATTERN_FILE, NULL) == -1)
+    {
+        perror(WORD_LIST_FILE);
+        exit(1);
+    }
+
+    test_feedback_kernels(&solver.dict);
+    test_letter_index(&solver.dict);
+    test_dict_file(&solver.dict);
+    test_book(&solver);
+    test_decision_table(&solver.dict);
+    test_decision_cache(&solver.dict);
+    test_prior(&solver);
+    test_pruned_scoring(&solver);
+    test_batch(&solver);
+    test_fixed_point(&solver);
+    test_deadline(&solver);
+    test_time_model(&solver);
+    test_rebuild(&solver);
+    test_speculation(&solver);
+    test_strategies(&solver);
+    test_endgame(&solver);
+
+    solver_close(&solver);
+    if (failures > 0)
+    {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}